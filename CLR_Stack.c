@@ -42,7 +42,18 @@ unsigned char * CLR_STACK_get_last_position(CLR_STACK* S){
 	return &S->memory_chunk[S->size_maximum-1];
 }
 
-CLR_STACK_ERROR_CODES CLR_STACK_init(CLR_STACK* S, unsigned char * mem_chunk, int size, CLR_STACK_OPERATION_MODES mode){
+bool CLR_STACK_is_over_watermark(CLR_STACK* S){
+	return (S->watermark_high_reached);
+}
+
+//Fires a watermark event, only called by push and pop once they have seen the watermark crossed
+void CLR_STACK_fire_watermark(CLR_STACK* S, CLR_STACK_WATERMARK_EVENTS event){
+	S->watermark_high_reached = (event == CLR_STACK_WATERMARK_HIGH);
+	if(S->watermark_callback != 0)
+		S->watermark_callback(S, event, S->watermark_context);
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_setup(CLR_STACK* S, unsigned char * mem_chunk, int size, CLR_STACK_OPERATION_MODES mode, bool clear){
 	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
 
 	if(mem_chunk != 0){
@@ -56,9 +67,18 @@ CLR_STACK_ERROR_CODES CLR_STACK_init(CLR_STACK* S, unsigned char * mem_chunk, in
 				S->size_current = 0;
 				S->size_maximum = size;
 
-				memset(S->memory_chunk, 0, size);
+				if(clear == true)
+					memset(S->memory_chunk, 0, size);
 
 				S->mode = mode;
+
+				S->watermark_high = 0;
+				S->watermark_low = 0;
+				S->watermark_high_reached = false;
+				S->watermark_callback = 0;
+				S->watermark_context = 0;
+
+				ret = CLR_STACK_SUCCESS;
 			}
 			else
 				ret = CLR_STACK_ERROR_WRONG_MODE;
@@ -69,7 +89,21 @@ CLR_STACK_ERROR_CODES CLR_STACK_init(CLR_STACK* S, unsigned char * mem_chunk, in
 	else
 		ret = CLR_STACK_ERROR_NULL_POINTER;
 
-	ret = CLR_STACK_SUCCESS;
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_init(CLR_STACK* S, unsigned char * mem_chunk, int size, CLR_STACK_OPERATION_MODES mode){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+
+	ret = CLR_STACK_setup(S, mem_chunk, size, mode, true);
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_init_no_clear(CLR_STACK* S, unsigned char * mem_chunk, int size, CLR_STACK_OPERATION_MODES mode){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+
+	ret = CLR_STACK_setup(S, mem_chunk, size, mode, false);
 
 	return ret;
 }
@@ -89,7 +123,7 @@ CLR_STACK_ERROR_CODES CLR_STACK_push(CLR_STACK* S, unsigned char * bytes, int si
 			{
 				memcpy(S->pointer_write, bytes, size);
 				S->pointer_write = S->pointer_write + size;
-				if (S->pointer_write >= CLR_STACK_get_last_position(S))
+				if (S->pointer_write > CLR_STACK_get_last_position(S))
 					S->pointer_write = S->memory_chunk;
 			}
 			else
@@ -108,6 +142,9 @@ CLR_STACK_ERROR_CODES CLR_STACK_push(CLR_STACK* S, unsigned char * bytes, int si
 			else
 				S->size_current = S->size_current + size;
 
+			if ((S->watermark_high > 0) && (S->watermark_high_reached == false) && (S->size_current >= S->watermark_high))
+				CLR_STACK_fire_watermark(S, CLR_STACK_WATERMARK_HIGH);
+
 			ret = CLR_STACK_SUCCESS;
 
 		}
@@ -131,21 +168,25 @@ CLR_STACK_ERROR_CODES CLR_STACK_get(CLR_STACK* S, unsigned char * bytes, int siz
 				memcpy(bytes, S->pointer_read, size);
 				if(peek == false){
 					S->pointer_read = S->pointer_read + size;
-					if(S->pointer_read >= CLR_STACK_get_last_position(S))
+					if(S->pointer_read > CLR_STACK_get_last_position(S))
 						S->pointer_read = S->memory_chunk;
 				}
 
 			}
 			else{
 				int remaining_size_before_end = CLR_STACK_get_last_position(S)-(S->pointer_read-1);
-				memcpy(bytes, S->pointer_read, size);
+				memcpy(bytes, S->pointer_read, remaining_size_before_end);
 				memcpy(&bytes[remaining_size_before_end], S->memory_chunk, size-remaining_size_before_end);
 				if(peek == false)
 					S->pointer_read = S->memory_chunk + size-remaining_size_before_end;
 			}
 
-			if(peek == false)
+			if(peek == false){
 				S->size_current = S->size_current - size;
+				//watermark_high_reached is always false while the watermarks are disabled
+				if((S->watermark_high_reached == true) && (S->size_current <= S->watermark_low))
+					CLR_STACK_fire_watermark(S, CLR_STACK_WATERMARK_LOW);
+			}
 			ret = CLR_STACK_SUCCESS;
 		}
 		else
@@ -173,5 +214,22 @@ CLR_STACK_ERROR_CODES CLR_STACK_peek(CLR_STACK* S, unsigned char * bytes, int si
 	return ret;
 }
 
+CLR_STACK_ERROR_CODES CLR_STACK_set_watermarks(CLR_STACK* S, int high, int low, CLR_STACK_WATERMARK_CALLBACK callback, void * context){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+
+	if((high == 0) || ((high > 0) && (high <= S->size_maximum) && (low >= 0) && (low < high))){
+		S->watermark_high = high;
+		S->watermark_low = low;
+		S->watermark_callback = callback;
+		S->watermark_context = context;
 
+		//No event for data already in the stack, but the state must match it so the next crossing is detected
+		S->watermark_high_reached = ((high > 0) && (S->size_current >= high));
 
+		ret = CLR_STACK_SUCCESS;
+	}
+	else
+		ret = CLR_STACK_ERROR_WRONG_SIZE;
+
+	return ret;
+}
@@ -24,6 +24,14 @@
 
 #include <stdbool.h>
 
+/**
+ * Size in bytes of a cache line in the target, used by the multi-thread helpers to keep data used by different threads apart.
+ * Define it before including this file if the target uses a different size.
+ * */
+#ifndef CLR_STACK_CACHE_LINE_SIZE
+#define CLR_STACK_CACHE_LINE_SIZE 64
+#endif
+
 /**
  * Returns given by the CLR_STACK functions
  */
@@ -35,6 +43,11 @@ typedef enum{
 	CLR_STACK_ERROR_WRONG_MODE			= -4,	///< Mode passed is not defined in CLR_STACK_OPERATION_MODES
 	CLR_STACK_ERROR_PUT_NOT_ENOUGH_SPACE = -5,	///< Struct is not working as a RING buffer, and you are trying to put more bytes than space remains
 	CLR_STACK_ERROR_POP_NOT_ENOUGH_BYTES = -6,	///< You are trying to pop more bytes than bytes there are in memory. Wait or try a lesser number
+	CLR_STACK_ERROR_TIMESTAMP_ORDER		= -7,	///< You are trying to push a record older than the newest one in a CLR_STACK_TIMED stack
+	CLR_STACK_ERROR_NO_MEMORY			= -8,	///< The memory block could not be allocated by the CLR_STACK_ALLOC helpers
+	CLR_STACK_ERROR_POOL_EMPTY			= -9,	///< All the slots of a CLR_STACK_POOL are allocated. Wait for a free or use a bigger pool
+	CLR_STACK_ERROR_OVERRUN				= -10,	///< The producer of a RING mode CLR_STACK_PINGPONG wrote over a buffer while it was being read
+	CLR_STACK_ERROR_WRONG_ALIGNMENT		= -11,	///< A structure passed is not aligned as its type requires, declare it statically or allocate it with aligned_alloc
 }CLR_STACK_ERROR_CODES;
 
 /**
@@ -45,6 +58,22 @@ typedef enum{
 	CLR_STACK_MODE_RING = 2,	///< Will work as a RING BUFFER, erasing old data in order to make space for new data.
 }CLR_STACK_OPERATION_MODES;
 
+/**
+ * Events reported by the watermark callback of a CLR_STACK structure
+ * */
+typedef enum{
+	CLR_STACK_WATERMARK_HIGH = 1,	///< A push has taken the used space up to the high watermark or above it.
+	CLR_STACK_WATERMARK_LOW = 2,	///< A pop has taken the used space down to the low watermark or below it, after a CLR_STACK_WATERMARK_HIGH event.
+}CLR_STACK_WATERMARK_EVENTS;
+
+struct st_CLR_STACK;
+
+/**
+ * Function called by CLR_STACK_push and CLR_STACK_pop when a watermark is crossed, see CLR_STACK_set_watermarks.
+ * It is called from inside push or pop, so it MUST NOT push or pop data on the same stack.
+ * */
+typedef void (*CLR_STACK_WATERMARK_CALLBACK)(struct st_CLR_STACK * S, CLR_STACK_WATERMARK_EVENTS event, void * context);
+
 /**
  * CLR_STACK Structure, manages a memory block passed with init, used to interact with all the CLR_STACK functions.
  * YOU SHALL NOT interact with its elements, the functions given below will manage it safely.
@@ -56,6 +85,11 @@ typedef struct st_CLR_STACK{
 	int size_maximum;				///< Total size of the stack in bytes, configured in the init function
 	int size_current;				///< Number of bytes with data on them
 	int mode;						///< Operation data of the stack
+	int watermark_high;				///< Used space that fires a CLR_STACK_WATERMARK_HIGH event, 0 if watermarks are disabled
+	int watermark_low;				///< Used space that fires a CLR_STACK_WATERMARK_LOW event
+	bool watermark_high_reached;	///< true from a CLR_STACK_WATERMARK_HIGH event until the next CLR_STACK_WATERMARK_LOW event
+	CLR_STACK_WATERMARK_CALLBACK watermark_callback;	///< Function called on every watermark event, can be NULL
+	void * watermark_context;		///< Pointer passed as is to watermark_callback
 }CLR_STACK;
 
 /**
@@ -98,6 +132,16 @@ int CLR_STACK_get_free_space(CLR_STACK* S);
  * */
 CLR_STACK_ERROR_CODES CLR_STACK_init(CLR_STACK* S, unsigned char * mem_chunk, int size, CLR_STACK_OPERATION_MODES mode);
 
+/**
+ * Same as CLR_STACK_init, but the memory block is not cleared.
+ * Data is never read before being written, so clearing is not needed. Skipping it saves the time of writing the whole block,
+ * and for memory blocks fresh from the OS (see CLR_Stack_Alloc.h) it leaves each page to be first touched by the thread that
+ * pushes into it, instead of the thread calling init.
+ *
+ * Parameters and returns are the same as in CLR_STACK_init.
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_init_no_clear(CLR_STACK* S, unsigned char * mem_chunk, int size, CLR_STACK_OPERATION_MODES mode);
+
 /**
  * Function for putting data in a PREVIOUSLY INITIALIZED CLR_STACK Structure.
  *
@@ -146,4 +190,30 @@ CLR_STACK_ERROR_CODES CLR_STACK_pop(CLR_STACK* S, unsigned char * bytes, int siz
  * */
 CLR_STACK_ERROR_CODES CLR_STACK_peek(CLR_STACK* S, unsigned char * bytes, int size);
 
+/**
+ * Function for configuring the watermarks of a PREVIOUSLY INITIALIZED CLR_STACK Structure, used for backpressure and flow control.
+ * When a push takes the used space up to high or above, a CLR_STACK_WATERMARK_HIGH event is fired. After that, no other event
+ * is fired until a pop takes the used space down to low or below, firing a CLR_STACK_WATERMARK_LOW event.
+ * The gap between high and low avoids firing events on every push and pop when the stack is used around a single level.
+ * Pushes and pops that do not cross a watermark pay only a comparison. Watermarks are disabled by CLR_STACK_init.
+ *
+ * \param S Pointer to the CLR_STACK structure to configure.
+ * \param high used space in BYTES that fires the CLR_STACK_WATERMARK_HIGH event, 0 to disable the watermarks.
+ * \param low used space in BYTES that fires the CLR_STACK_WATERMARK_LOW event, it must be smaller than high.
+ * \param callback function called on every event, can be NULL if only CLR_STACK_is_over_watermark is used.
+ * \param context pointer passed as is to callback.
+ *
+ * \returns A CLR_STACK_ERROR_CODES value:
+ * \li CLR_STACK_SUCCESS if configuration succesful.
+ * \li CLR_STACK_ERROR_WRONG_SIZE if high > size_maximum, or low < 0 or low >= high when high is not 0.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_set_watermarks(CLR_STACK* S, int high, int low, CLR_STACK_WATERMARK_CALLBACK callback, void * context);
+
+/**
+ * Returns if the passed CLR_STACK structure is over its watermark, meaning that the last event was a CLR_STACK_WATERMARK_HIGH one.
+ * Can be polled instead of (or besides) using a callback.
+ * */
+bool CLR_STACK_is_over_watermark(CLR_STACK* S);
+
 #endif //__CLR_STACK_H_
@@ -0,0 +1,182 @@
+/////////////////////////////////////////////////
+//
+//	This file is part of CLR_Stack.
+//
+//	CLR_Stack is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	CLR_Stack is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with CLR_Stack.  If not, see <https://www.gnu.org/licenses/>.
+//
+/////////////////////////////////////////////////
+
+#ifdef __linux__
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "CLR_Stack_Alloc.h"
+
+#ifdef __linux__
+
+#define CLR_STACK_ALLOC_NUMA_NODES_MAXIMUM 1024	// Highest NUMA node number + 1 that can be requested
+#define CLR_STACK_ALLOC_MPOL_PREFERRED 1		// MPOL_PREFERRED from the kernel headers, numaif.h is part of libnuma and may not be installed
+
+//Rounds size up to a multiple of page_size
+unsigned long CLR_STACK_ALLOC_round_up(unsigned long size, unsigned long page_size){
+	return ((size + page_size - 1) / page_size) * page_size;
+}
+
+//Maps size_mapped bytes aligned to a huge page and flags them for transparent huge pages, returns 0 if it fails.
+//huge is set to false if the OS refused the flag (or does not know it), the mapping is kept but uses normal pages.
+unsigned char * CLR_STACK_ALLOC_map_transparent(unsigned long size_mapped, bool * huge){
+	unsigned char * ret = 0;
+	unsigned char * mapped = 0;
+	unsigned long head = 0;
+	unsigned long tail = 0;
+
+	//Map an extra huge page, so an aligned block can be cut out of it
+	mapped = mmap(0, size_mapped + CLR_STACK_ALLOC_HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(mapped != MAP_FAILED){
+		head = CLR_STACK_ALLOC_round_up((uintptr_t)mapped, CLR_STACK_ALLOC_HUGE_PAGE_SIZE) - (uintptr_t)mapped;
+		tail = CLR_STACK_ALLOC_HUGE_PAGE_SIZE - head;
+		if(head > 0)
+			munmap(mapped, head);
+		if(tail > 0)
+			munmap(mapped + head + size_mapped, tail);
+
+		ret = mapped + head;
+#ifdef MADV_HUGEPAGE
+		*huge = (madvise(ret, size_mapped, MADV_HUGEPAGE) == 0);
+#else
+		*huge = false;
+#endif
+	}
+
+	return ret;
+}
+
+//Makes numa_node the preferred node of the memory block before it is touched, returns false if the node could not be used.
+//The policy is not strict: pages the node can not give when they are first touched come from other nodes.
+bool CLR_STACK_ALLOC_bind(unsigned char * memory_chunk, unsigned long size_mapped, int numa_node){
+	bool ret = false;
+#ifdef SYS_mbind
+	unsigned long nodemask[CLR_STACK_ALLOC_NUMA_NODES_MAXIMUM / (8 * sizeof(unsigned long))] = { 0 };
+	const unsigned long bits_per_word = 8 * sizeof(unsigned long);
+
+	if((numa_node >= 0) && (numa_node < CLR_STACK_ALLOC_NUMA_NODES_MAXIMUM)){
+		nodemask[numa_node / bits_per_word] = 1UL << (numa_node % bits_per_word);
+		//The kernel ignores the last bit of maxnode, so one more than the number of nodes is passed
+		ret = (syscall(SYS_mbind, memory_chunk, size_mapped, CLR_STACK_ALLOC_MPOL_PREFERRED, nodemask, CLR_STACK_ALLOC_NUMA_NODES_MAXIMUM + 1, 0) == 0);
+	}
+#else
+	(void)memory_chunk;
+	(void)size_mapped;
+	(void)numa_node;
+#endif
+
+	return ret;
+}
+
+#endif
+
+CLR_STACK_ERROR_CODES CLR_STACK_ALLOC_create(CLR_STACK_ALLOC* A, int size, CLR_STACK_ALLOC_PAGES pages, int numa_node){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+#ifdef __linux__
+	unsigned char * mapped = 0;
+	bool huge = false;
+#endif
+
+	if(A != 0){
+		if(size > 0){
+			if(pages >= CLR_STACK_ALLOC_PAGES_NORMAL && pages <= CLR_STACK_ALLOC_PAGES_HUGE_EXPLICIT){
+				A->memory_chunk = 0;
+				A->size = size;
+				A->numa_node = -1;
+#ifdef __linux__
+				if(pages == CLR_STACK_ALLOC_PAGES_HUGE_EXPLICIT){
+#ifdef MAP_HUGETLB
+					A->size_mapped = CLR_STACK_ALLOC_round_up(size, CLR_STACK_ALLOC_HUGE_PAGE_SIZE);
+					mapped = mmap(0, A->size_mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+					if(mapped != MAP_FAILED)
+						A->memory_chunk = mapped;
+					else
+#endif
+						pages = CLR_STACK_ALLOC_PAGES_HUGE_TRANSPARENT;
+				}
+
+				if(pages == CLR_STACK_ALLOC_PAGES_HUGE_TRANSPARENT){
+					A->size_mapped = CLR_STACK_ALLOC_round_up(size, CLR_STACK_ALLOC_HUGE_PAGE_SIZE);
+					A->memory_chunk = CLR_STACK_ALLOC_map_transparent(A->size_mapped, &huge);
+					if((A->memory_chunk == 0) || (huge == false))
+						pages = CLR_STACK_ALLOC_PAGES_NORMAL;
+				}
+
+				if((pages == CLR_STACK_ALLOC_PAGES_NORMAL) && (A->memory_chunk == 0)){
+					A->size_mapped = CLR_STACK_ALLOC_round_up(size, sysconf(_SC_PAGESIZE));
+					mapped = mmap(0, A->size_mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+					if(mapped != MAP_FAILED)
+						A->memory_chunk = mapped;
+				}
+
+				if((A->memory_chunk != 0) && CLR_STACK_ALLOC_bind(A->memory_chunk, A->size_mapped, numa_node))
+					A->numa_node = numa_node;
+#else
+				(void)numa_node;
+				pages = CLR_STACK_ALLOC_PAGES_NORMAL;
+				A->size_mapped = size;
+				A->memory_chunk = malloc(size);
+#endif
+				A->pages = pages;
+
+				if(A->memory_chunk != 0)
+					ret = CLR_STACK_SUCCESS;
+				else
+					ret = CLR_STACK_ERROR_NO_MEMORY;
+			}
+			else
+				ret = CLR_STACK_ERROR_WRONG_MODE;
+		}
+		else
+			ret = CLR_STACK_ERROR_WRONG_SIZE;
+	}
+	else
+		ret = CLR_STACK_ERROR_NULL_POINTER;
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_ALLOC_destroy(CLR_STACK_ALLOC* A){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+
+	if((A != 0) && (A->memory_chunk != 0)){
+#ifdef __linux__
+		munmap(A->memory_chunk, A->size_mapped);
+#else
+		free(A->memory_chunk);
+#endif
+		A->memory_chunk = 0;
+		A->size_mapped = 0;
+
+		ret = CLR_STACK_SUCCESS;
+	}
+	else
+		ret = CLR_STACK_ERROR_NULL_POINTER;
+
+	return ret;
+}
@@ -0,0 +1,94 @@
+/////////////////////////////////////////////////
+//
+//	This file is part of CLR_Stack.
+//
+//	CLR_Stack is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	CLR_Stack is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with CLR_Stack.  If not, see <https://www.gnu.org/licenses/>.
+//
+/////////////////////////////////////////////////
+
+#ifndef __CLR_STACK_ALLOC_H_
+#define __CLR_STACK_ALLOC_H_
+
+#include <stdbool.h>
+
+#include "CLR_Stack.h"
+
+/**
+ * Size in bytes of a huge page in the target. Memory blocks using huge pages are rounded up to a multiple of it.
+ * Define it before including this file if the target uses a different size.
+ * */
+#ifndef CLR_STACK_ALLOC_HUGE_PAGE_SIZE
+#define CLR_STACK_ALLOC_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#endif
+
+/**
+ * Kind of pages backing a memory block allocated with CLR_STACK_ALLOC_create
+ * */
+typedef enum{
+	CLR_STACK_ALLOC_PAGES_NORMAL = 0,			///< Normal pages of the OS.
+	CLR_STACK_ALLOC_PAGES_HUGE_TRANSPARENT = 1,	///< Normal pages, aligned and flagged so the OS can merge them into transparent huge pages.
+	CLR_STACK_ALLOC_PAGES_HUGE_EXPLICIT = 2,	///< Huge pages reserved in the OS (hugetlbfs). Falls back to transparent huge pages if none are free.
+}CLR_STACK_ALLOC_PAGES;
+
+/**
+ * CLR_STACK_ALLOC Structure, holds a memory block allocated directly from the OS to be managed by a CLR_STACK (or any other stack type).
+ * Only memory_chunk, pages and numa_node may be read, the functions given below will manage the rest.
+ * On targets without mmap (anything but Linux) the block comes from malloc, with normal pages and no NUMA node.
+ * */
+typedef struct st_CLR_STACK_ALLOC{
+	unsigned char * memory_chunk;	///< Pointer to the allocated memory block, pass it to the init function of the stack
+	int size;						///< Size in bytes requested in CLR_STACK_ALLOC_create
+	unsigned long size_mapped;		///< Size in bytes actually allocated, rounded up to whole pages
+	CLR_STACK_ALLOC_PAGES pages;	///< Kind of pages actually obtained, may be less than the requested one
+	int numa_node;					///< NUMA node preferred for the memory block, -1 if it is left to the OS
+}CLR_STACK_ALLOC;
+
+/**
+ * Function for allocating a memory block from the OS with the requested kind of pages, placed on a NUMA node.
+ * When the requested pages or node are not available the block is still allocated with what the OS can give,
+ * check pages and numa_node in A to know what was obtained.
+ * The node is preferred, not enforced: if it runs out of memory (or of huge pages) when the block is first touched,
+ * the missing pages come from other nodes instead of the process being killed.
+ * The memory block is NOT touched, use CLR_STACK_init_no_clear from the thread that will use the stack
+ * so the pages are first touched where they will be used.
+ *
+ * \param A Pointer to the CLR_STACK_ALLOC structure that will hold the memory block.
+ * \param size the size in BYTES of the memory block.
+ * \param pages the kind of pages wanted for the memory block.
+ * \param numa_node the NUMA node the memory block should be placed on, -1 to leave it to the OS.
+ *
+ * \returns A CLR_STACK_ERROR_CODES value.
+ * \li CLR_STACK_SUCCESS if the memory block was allocated, even if with fallbacks.
+ * \li CLR_STACK_ERROR_WRONG_SIZE if size < 1.
+ * \li CLR_STACK_ERROR_WRONG_MODE if pages is not included in CLR_STACK_ALLOC_PAGES.
+ * \li CLR_STACK_ERROR_NO_MEMORY if the OS could not give a memory block of that size.
+ * \li CLR_STACK_ERROR_NULL_POINTER if A is a NULL pointer.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_ALLOC_create(CLR_STACK_ALLOC* A, int size, CLR_STACK_ALLOC_PAGES pages, int numa_node);
+
+/**
+ * Function for giving back to the OS a memory block allocated with CLR_STACK_ALLOC_create.
+ * The stack managing it MUST NOT be used anymore.
+ *
+ * \param A Pointer to the CLR_STACK_ALLOC structure holding the memory block.
+ *
+ * \returns A CLR_STACK_ERROR_CODES value.
+ * \li CLR_STACK_SUCCESS if the memory block was released.
+ * \li CLR_STACK_ERROR_NULL_POINTER if A or its memory block is a NULL pointer.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_ALLOC_destroy(CLR_STACK_ALLOC* A);
+
+#endif //__CLR_STACK_ALLOC_H_
@@ -0,0 +1,220 @@
+/////////////////////////////////////////////////
+//
+//	This file is part of CLR_Stack.
+//
+//	CLR_Stack is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	CLR_Stack is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with CLR_Stack.  If not, see <https://www.gnu.org/licenses/>.
+//
+/////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "CLR_Stack_PingPong.h"
+
+//Counters only grow and wrap around, so they are always compared through their difference.
+//Buffer n (counting flips since init) is always held in position n % buffers_count.
+
+//Returns the position in memory of the buffer with sequence number sequence
+unsigned char * CLR_STACK_PINGPONG_get_buffer(CLR_STACK_PINGPONG* B, unsigned int sequence){
+	return &B->buffers[(sequence % (unsigned int)B->buffers_count) * B->buffer_size];
+}
+
+//Returns true if the producer can write the buffer of sequence flips. In RING mode it always can.
+bool CLR_STACK_PINGPONG_can_write(CLR_STACK_PINGPONG* B, unsigned int flips){
+	bool ret = true;
+
+	if(B->mode == CLR_STACK_MODE_FIFO)
+		ret = ((flips - atomic_load_explicit(&B->releases, memory_order_acquire)) < (unsigned int)B->buffers_count);
+
+	return ret;
+}
+
+unsigned int CLR_STACK_PINGPONG_get_flips(CLR_STACK_PINGPONG* B){
+	return (atomic_load_explicit(&B->flips, memory_order_relaxed));
+}
+
+int CLR_STACK_PINGPONG_get_used_buffers(CLR_STACK_PINGPONG* B){
+	return ((int)(atomic_load_explicit(&B->flips, memory_order_relaxed) - atomic_load_explicit(&B->releases, memory_order_relaxed)));
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_PINGPONG_init(CLR_STACK_PINGPONG* B, unsigned char * mem_chunk, int size, int buffers_count, CLR_STACK_OPERATION_MODES mode){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+	int misalignment = 0;
+	int header_size = 0;
+	int buffer_size = 0;
+	int i = 0;
+
+	if((B != 0) && (mem_chunk != 0)){
+		misalignment = (int)((uintptr_t)mem_chunk % CLR_STACK_CACHE_LINE_SIZE);
+		if(misalignment != 0)
+			misalignment = CLR_STACK_CACHE_LINE_SIZE - misalignment;
+
+		//The lengths go first, rounded up to a cache line so every buffer starts on one
+		if(buffers_count > 1){
+			header_size = (int)(((buffers_count * sizeof(int)) + CLR_STACK_CACHE_LINE_SIZE - 1) / CLR_STACK_CACHE_LINE_SIZE) * CLR_STACK_CACHE_LINE_SIZE;
+			if((size - misalignment - header_size) > 0)
+				buffer_size = (((size - misalignment - header_size) / buffers_count) / CLR_STACK_CACHE_LINE_SIZE) * CLR_STACK_CACHE_LINE_SIZE;
+		}
+
+		if(((uintptr_t)B % _Alignof(CLR_STACK_PINGPONG)) != 0){
+			ret = CLR_STACK_ERROR_WRONG_ALIGNMENT;
+		}
+		else if(buffer_size > 0){
+			if (mode > 0 && mode < 3)
+			{
+				B->lengths = (int *)(mem_chunk + misalignment);
+				B->buffers = mem_chunk + misalignment + header_size;
+				B->buffer_size = buffer_size;
+				B->buffers_count = buffers_count;
+				B->mode = mode;
+
+				for(i = 0; i < buffers_count; i++)
+					B->lengths[i] = 0;
+
+				atomic_init(&B->flips, 0);
+				atomic_init(&B->releases, 0);
+
+				ret = CLR_STACK_SUCCESS;
+			}
+			else
+				ret = CLR_STACK_ERROR_WRONG_MODE;
+		}
+		else
+			ret = CLR_STACK_ERROR_WRONG_SIZE;
+	}
+	else
+		ret = CLR_STACK_ERROR_NULL_POINTER;
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_PINGPONG_get_write_buffer(CLR_STACK_PINGPONG* B, unsigned char ** buffer, int * size){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+	unsigned int flips = 0;
+
+	if (buffer != 0)
+	{
+		flips = atomic_load_explicit(&B->flips, memory_order_relaxed);
+
+		if (CLR_STACK_PINGPONG_can_write(B, flips))
+		{
+			*buffer = CLR_STACK_PINGPONG_get_buffer(B, flips);
+			if (size != 0)
+				*size = B->buffer_size;
+
+			ret = CLR_STACK_SUCCESS;
+		}
+		else
+			ret = CLR_STACK_ERROR_PUT_NOT_ENOUGH_SPACE;
+	}
+	else
+		ret = CLR_STACK_ERROR_NULL_POINTER;
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_PINGPONG_flip(CLR_STACK_PINGPONG* B, int length){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+	unsigned int flips = 0;
+
+	if ((length >= 0) && (length <= B->buffer_size))
+	{
+		flips = atomic_load_explicit(&B->flips, memory_order_relaxed);
+
+		if (CLR_STACK_PINGPONG_can_write(B, flips))
+		{
+			B->lengths[flips % (unsigned int)B->buffers_count] = length;
+
+			//Release, so the consumer sees the data and the length once it sees the new counter
+			atomic_store_explicit(&B->flips, flips + 1, memory_order_release);
+			//Pairs with the acquire fence in CLR_STACK_PINGPONG_release: the writes into the next buffer can not be seen
+			//before the new counter, so a consumer lapped in RING mode always finds out
+			atomic_thread_fence(memory_order_release);
+
+			ret = CLR_STACK_SUCCESS;
+		}
+		else
+			ret = CLR_STACK_ERROR_PUT_NOT_ENOUGH_SPACE;
+	}
+	else
+		ret = CLR_STACK_ERROR_WRONG_SIZE;
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_PINGPONG_get_read_buffer(CLR_STACK_PINGPONG* B, unsigned char ** buffer, int * length, unsigned int * missed){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+	unsigned int flips = 0;
+	unsigned int releases = 0;
+	unsigned int skipped = 0;
+
+	if ((buffer != 0) && (length != 0))
+	{
+		flips = atomic_load_explicit(&B->flips, memory_order_acquire);
+		releases = atomic_load_explicit(&B->releases, memory_order_relaxed);
+
+		//In RING mode the producer may already be writing the buffer of sequence flips, which is the oldest one once
+		//buffers_count - 1 buffers are waiting. Older buffers are lost.
+		if ((B->mode == CLR_STACK_MODE_RING) && ((flips - releases) > (unsigned int)(B->buffers_count - 1)))
+		{
+			skipped = (flips - releases) - (B->buffers_count - 1);
+			releases = releases + skipped;
+			atomic_store_explicit(&B->releases, releases, memory_order_release);
+		}
+
+		if (missed != 0)
+			*missed = skipped;
+
+		if (flips != releases)
+		{
+			*buffer = CLR_STACK_PINGPONG_get_buffer(B, releases);
+			*length = B->lengths[releases % (unsigned int)B->buffers_count];
+
+			ret = CLR_STACK_SUCCESS;
+		}
+		else
+			ret = CLR_STACK_ERROR_POP_NOT_ENOUGH_BYTES;
+	}
+	else
+		ret = CLR_STACK_ERROR_NULL_POINTER;
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_PINGPONG_release(CLR_STACK_PINGPONG* B){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+	unsigned int flips = 0;
+	unsigned int releases = 0;
+
+	//Acquire, so the check is done after all the reads of the buffer
+	atomic_thread_fence(memory_order_acquire);
+	flips = atomic_load_explicit(&B->flips, memory_order_acquire);
+	releases = atomic_load_explicit(&B->releases, memory_order_relaxed);
+
+	if (flips != releases)
+	{
+		//In RING mode the producer moves into the buffer being read once it has flipped buffers_count buffers after it
+		if ((B->mode == CLR_STACK_MODE_RING) && ((flips - releases) >= (unsigned int)B->buffers_count))
+			ret = CLR_STACK_ERROR_OVERRUN;
+		else
+			ret = CLR_STACK_SUCCESS;
+
+		atomic_store_explicit(&B->releases, releases + 1, memory_order_release);
+	}
+	else
+		ret = CLR_STACK_ERROR_POP_NOT_ENOUGH_BYTES;
+
+	return ret;
+}
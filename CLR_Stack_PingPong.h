@@ -0,0 +1,141 @@
+/////////////////////////////////////////////////
+//
+//	This file is part of CLR_Stack.
+//
+//	CLR_Stack is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	CLR_Stack is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with CLR_Stack.  If not, see <https://www.gnu.org/licenses/>.
+//
+/////////////////////////////////////////////////
+
+#ifndef __CLR_STACK_PINGPONG_H_
+#define __CLR_STACK_PINGPONG_H_
+
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "CLR_Stack.h"
+
+/**
+ * CLR_STACK_PINGPONG Structure, manages a memory block passed with init as N buffers (2 for classic ping-pong) handed over
+ * whole from one producer to one consumer, without copying. The producer fills a buffer in place and flips it,
+ * the consumer gets a pointer to the oldest flipped buffer and releases it once done.
+ * Flips and releases are counted, so in RING mode a consumer too slow for the producer knows how many buffers it missed
+ * and if the buffer it was reading was overwritten.
+ * The structure MUST be aligned to CLR_STACK_CACHE_LINE_SIZE: declare it statically (or on the stack), or allocate it
+ * with aligned_alloc. malloc only guarantees the alignment of max_align_t, which is usually smaller.
+ * YOU SHALL NOT interact with its elements, the functions given below will manage it safely.
+ * */
+typedef struct st_CLR_STACK_PINGPONG{
+	unsigned char * buffers;		///< Pointer to the first buffer, buffers are consecutive and start on a cache line
+	int * lengths;					///< Bytes written by the producer in each buffer, set on flip
+	int buffer_size;				///< Size of every buffer in bytes
+	int buffers_count;				///< Number of buffers, configured in the init function
+	int mode;						///< Operation mode, FIFO makes the producer wait for the consumer, RING never does
+	_Alignas(CLR_STACK_CACHE_LINE_SIZE) atomic_uint flips;	///< Buffers flipped by the producer since init, only written by the producer
+	_Alignas(CLR_STACK_CACHE_LINE_SIZE) atomic_uint releases;	///< Buffers released (or missed) by the consumer since init, only written by the consumer
+}CLR_STACK_PINGPONG;
+
+/**
+ * Returns the number of buffers flipped by the producer of the passed CLR_STACK_PINGPONG structure since init.
+ * The counter wraps around, compare values by subtracting them.
+ * */
+unsigned int CLR_STACK_PINGPONG_get_flips(CLR_STACK_PINGPONG* B);
+
+/**
+ * Returns the number of buffers flipped and not released yet in the passed CLR_STACK_PINGPONG structure.
+ * In RING mode it can be bigger than the number of buffers if the consumer has been lapped.
+ * */
+int CLR_STACK_PINGPONG_get_used_buffers(CLR_STACK_PINGPONG* B);
+
+/**
+ * Function for set-up and start managing the memory passed in mem_chunk (of size size) in the CLR_STACK_PINGPONG structure B
+ * as buffers_count buffers of mode mode. The memory block is split evenly, after a small header with the length of every buffer.
+ * This function MUST be called before any other for succesfull operation, and before the producer and consumer use it.
+ *
+ * \param B Pointer to the CLR_STACK_PINGPONG structure that will manage te memory block
+ * \param mem_chunk pointer to the memory block that will be managed by the CLR_STACK_PINGPONG structure
+ * \param size the size in BYTES of the memory block
+ * \param buffers_count number of buffers, at least 2
+ * \param mode the operation mode, FIFO rejects flips while all the buffers are waiting for the consumer, RING overwrites the oldest one
+ *
+ * \returns A CLR_STACK_ERROR_CODES value.
+ * \li CLR_STACK_SUCCESS if init succesful.
+ * \li CLR_STACK_ERROR_WRONG_SIZE if buffers_count < 2 or the memory block can not hold a cache line per buffer.
+ * \li CLR_STACK_ERROR_WRONG_MODE if the mode passed is not included in CLR_STACK_OPERATION_MODES.
+ * \li CLR_STACK_ERROR_WRONG_ALIGNMENT if B is not aligned to CLR_STACK_CACHE_LINE_SIZE.
+ * \li CLR_STACK_ERROR_NULL_POINTER if B or mem_chunk is a NULL pointer.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_PINGPONG_init(CLR_STACK_PINGPONG* B, unsigned char * mem_chunk, int size, int buffers_count, CLR_STACK_OPERATION_MODES mode);
+
+/**
+ * Function for the producer to get the buffer to fill. It can be called again to get the same buffer until it is flipped.
+ *
+ * \param B Pointer to the CLR_STACK_PINGPONG structure.
+ * \param buffer pointer in which the address of the buffer will be written.
+ * \param size pointer in which the size in BYTES of the buffer will be written, can be NULL if not needed.
+ *
+ * \returns A CLR_STACK_ERROR_CODES value:
+ * \li CLR_STACK_SUCCESS if the buffer can be written.
+ * \li CLR_STACK_ERROR_PUT_NOT_ENOUGH_SPACE in FIFO mode, if all the buffers are waiting for the consumer.
+ * \li CLR_STACK_ERROR_NULL_POINTER if buffer is a NULL pointer.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_PINGPONG_get_write_buffer(CLR_STACK_PINGPONG* B, unsigned char ** buffer, int * size);
+
+/**
+ * Function for the producer to hand the buffer it filled over to the consumer, moving on to the next one.
+ *
+ * \param B Pointer to the CLR_STACK_PINGPONG structure.
+ * \param length number of BYTES written in the buffer.
+ *
+ * \returns A CLR_STACK_ERROR_CODES value:
+ * \li CLR_STACK_SUCCESS if flip succesful.
+ * \li CLR_STACK_ERROR_WRONG_SIZE if length < 0 or length > buffer size.
+ * \li CLR_STACK_ERROR_PUT_NOT_ENOUGH_SPACE in FIFO mode, if all the buffers are waiting for the consumer.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_PINGPONG_flip(CLR_STACK_PINGPONG* B, int length);
+
+/**
+ * Function for the consumer to get the oldest buffer flipped by the producer, in place. It can be called again to get
+ * the same buffer until it is released. In RING mode, buffers the producer already started overwriting are skipped.
+ *
+ * \param B Pointer to the CLR_STACK_PINGPONG structure.
+ * \param buffer pointer in which the address of the buffer will be written.
+ * \param length pointer in which the number of BYTES written in the buffer by the producer will be written.
+ * \param missed pointer in which the number of buffers skipped because the producer overwrote them will be written, can be NULL.
+ *
+ * \returns A CLR_STACK_ERROR_CODES value:
+ * \li CLR_STACK_SUCCESS if a buffer is ready to be read.
+ * \li CLR_STACK_ERROR_POP_NOT_ENOUGH_BYTES if no buffer was flipped since the last release.
+ * \li CLR_STACK_ERROR_NULL_POINTER if buffer or length is a NULL pointer.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_PINGPONG_get_read_buffer(CLR_STACK_PINGPONG* B, unsigned char ** buffer, int * length, unsigned int * missed);
+
+/**
+ * Function for the consumer to give back the buffer got with CLR_STACK_PINGPONG_get_read_buffer to the producer.
+ *
+ * \param B Pointer to the CLR_STACK_PINGPONG structure.
+ *
+ * \returns A CLR_STACK_ERROR_CODES value:
+ * \li CLR_STACK_SUCCESS if the buffer was released and the producer did not touch it while it was being read.
+ * \li CLR_STACK_ERROR_OVERRUN in RING mode, if the producer started overwriting the buffer while it was being read,
+ * the data read from it must be discarded. The buffer is released anyway.
+ * \li CLR_STACK_ERROR_POP_NOT_ENOUGH_BYTES if there is no flipped buffer to release.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_PINGPONG_release(CLR_STACK_PINGPONG* B);
+
+#endif //__CLR_STACK_PINGPONG_H_
@@ -0,0 +1,189 @@
+/////////////////////////////////////////////////
+//
+//	This file is part of CLR_Stack.
+//
+//	CLR_Stack is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	CLR_Stack is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with CLR_Stack.  If not, see <https://www.gnu.org/licenses/>.
+//
+/////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "CLR_Stack_Pool.h"
+
+#define CLR_STACK_POOL_NONE 0xFFFFFFFFULL		// Index stored in free_head when there is no free slot
+#define CLR_STACK_POOL_INDEX_MASK 0xFFFFFFFFULL	// Bits of free_head holding the index
+#define CLR_STACK_POOL_TAG_ONE (1ULL << 32)		// Value added to free_head on every change, in the bits above the index
+
+//Each free slot holds the index of the next free slot in its first bytes. It is atomic because a lock-free alloc may read it
+//while another thread, that just took the slot, writes its data there. The value read is then discarded by the failed exchange.
+atomic_int * CLR_STACK_POOL_get_next(CLR_STACK_POOL* P, unsigned long long index){
+	return (atomic_int *)&P->slots[index * P->slot_size];
+}
+
+//Adds count to the number of free slots, only lock-free pools pay for an atomic read-modify-write
+void CLR_STACK_POOL_add_free(CLR_STACK_POOL* P, int count){
+	if(P->mode == CLR_STACK_POOL_MODE_LOCK_FREE)
+		atomic_fetch_add_explicit(&P->slots_free, count, memory_order_relaxed);
+	else
+		atomic_store_explicit(&P->slots_free, atomic_load_explicit(&P->slots_free, memory_order_relaxed) + count, memory_order_relaxed);
+}
+
+bool CLR_STACK_POOL_is_empty(CLR_STACK_POOL* P){
+	return (atomic_load_explicit(&P->slots_free, memory_order_relaxed) == 0);
+}
+
+bool CLR_STACK_POOL_is_full(CLR_STACK_POOL* P){
+	return (atomic_load_explicit(&P->slots_free, memory_order_relaxed) == P->slots_maximum);
+}
+
+int CLR_STACK_POOL_get_free_slots(CLR_STACK_POOL* P){
+	return (atomic_load_explicit(&P->slots_free, memory_order_relaxed));
+}
+
+unsigned char * CLR_STACK_POOL_get_slot(CLR_STACK_POOL* P, int index){
+	unsigned char * ret = 0;
+
+	if((index >= 0) && (index < P->slots_maximum))
+		ret = &P->slots[index * P->slot_size];
+
+	return ret;
+}
+
+int CLR_STACK_POOL_get_index(CLR_STACK_POOL* P, unsigned char * slot){
+	int ret = -1;
+
+	if((slot >= P->slots) && (slot < &P->slots[P->slots_maximum * P->slot_size]))
+		ret = (int)((slot - P->slots) / P->slot_size);
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_POOL_init(CLR_STACK_POOL* P, unsigned char * mem_chunk, int size, int object_size, CLR_STACK_POOL_MODES mode){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+	int misalignment = 0;
+	int slot_size = 0;
+	int i = 0;
+
+	if((P != 0) && (mem_chunk != 0)){
+		misalignment = (int)((uintptr_t)mem_chunk % CLR_STACK_CACHE_LINE_SIZE);
+		if(misalignment != 0)
+			misalignment = CLR_STACK_CACHE_LINE_SIZE - misalignment;
+
+		if(object_size > 0)
+			slot_size = ((object_size + CLR_STACK_CACHE_LINE_SIZE - 1) / CLR_STACK_CACHE_LINE_SIZE) * CLR_STACK_CACHE_LINE_SIZE;
+
+		if((slot_size > 0) && ((size - misalignment) >= slot_size)){
+			if (mode > 0 && mode < 3)
+			{
+				P->slots = mem_chunk + misalignment;
+				P->slot_size = slot_size;
+				P->slots_maximum = (size - misalignment) / slot_size;
+				P->mode = mode;
+
+				//All the slots are free, linked in order
+				for(i = 0; i < (P->slots_maximum - 1); i++)
+					atomic_init(CLR_STACK_POOL_get_next(P, i), i + 1);
+				atomic_init(CLR_STACK_POOL_get_next(P, P->slots_maximum - 1), (int)CLR_STACK_POOL_NONE);
+
+				atomic_init(&P->free_head, 0);
+				atomic_init(&P->slots_free, P->slots_maximum);
+
+				ret = CLR_STACK_SUCCESS;
+			}
+			else
+				ret = CLR_STACK_ERROR_WRONG_MODE;
+		}
+		else
+			ret = CLR_STACK_ERROR_WRONG_SIZE;
+	}
+	else
+		ret = CLR_STACK_ERROR_NULL_POINTER;
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_POOL_alloc(CLR_STACK_POOL* P, int * index){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+	unsigned long long head = 0;
+	unsigned long long head_new = 0;
+	bool done = false;
+
+	if (index != 0)
+	{
+		head = atomic_load_explicit(&P->free_head, memory_order_acquire);
+
+		while ((done == false) && ((head & CLR_STACK_POOL_INDEX_MASK) != CLR_STACK_POOL_NONE))
+		{
+			//The next free slot may be stale if another thread took this one meanwhile, then the tag has changed and the exchange fails
+			head_new = ((head & ~CLR_STACK_POOL_INDEX_MASK) + CLR_STACK_POOL_TAG_ONE)
+					| ((unsigned int)atomic_load_explicit(CLR_STACK_POOL_get_next(P, head & CLR_STACK_POOL_INDEX_MASK), memory_order_relaxed));
+
+			if (P->mode == CLR_STACK_POOL_MODE_LOCK_FREE)
+				done = atomic_compare_exchange_weak_explicit(&P->free_head, &head, head_new, memory_order_acquire, memory_order_acquire);
+			else
+			{
+				atomic_store_explicit(&P->free_head, head_new, memory_order_relaxed);
+				done = true;
+			}
+		}
+
+		if (done == true)
+		{
+			*index = (int)(head & CLR_STACK_POOL_INDEX_MASK);
+			CLR_STACK_POOL_add_free(P, -1);
+			ret = CLR_STACK_SUCCESS;
+		}
+		else
+			ret = CLR_STACK_ERROR_POOL_EMPTY;
+	}
+	else
+		ret = CLR_STACK_ERROR_NULL_POINTER;
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_POOL_free(CLR_STACK_POOL* P, int index){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+	unsigned long long head = 0;
+	unsigned long long head_new = 0;
+	bool done = false;
+
+	if ((index >= 0) && (index < P->slots_maximum))
+	{
+		head = atomic_load_explicit(&P->free_head, memory_order_relaxed);
+
+		while (done == false)
+		{
+			atomic_store_explicit(CLR_STACK_POOL_get_next(P, index), (int)(head & CLR_STACK_POOL_INDEX_MASK), memory_order_relaxed);
+			head_new = ((head & ~CLR_STACK_POOL_INDEX_MASK) + CLR_STACK_POOL_TAG_ONE) | (unsigned int)index;
+
+			if (P->mode == CLR_STACK_POOL_MODE_LOCK_FREE)
+				done = atomic_compare_exchange_weak_explicit(&P->free_head, &head, head_new, memory_order_release, memory_order_relaxed);
+			else
+			{
+				atomic_store_explicit(&P->free_head, head_new, memory_order_relaxed);
+				done = true;
+			}
+		}
+
+		CLR_STACK_POOL_add_free(P, 1);
+		ret = CLR_STACK_SUCCESS;
+	}
+	else
+		ret = CLR_STACK_ERROR_WRONG_SIZE;
+
+	return ret;
+}
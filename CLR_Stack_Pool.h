@@ -0,0 +1,126 @@
+/////////////////////////////////////////////////
+//
+//	This file is part of CLR_Stack.
+//
+//	CLR_Stack is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	CLR_Stack is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with CLR_Stack.  If not, see <https://www.gnu.org/licenses/>.
+//
+/////////////////////////////////////////////////
+
+#ifndef __CLR_STACK_POOL_H_
+#define __CLR_STACK_POOL_H_
+
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "CLR_Stack.h"
+
+/**
+ * Modes of operation of the CLR_STACK_POOL structure
+ * */
+typedef enum{
+	CLR_STACK_POOL_MODE_SINGLE_THREAD = 1,	///< Alloc and free are only called from one thread (or protected by the caller).
+	CLR_STACK_POOL_MODE_LOCK_FREE = 2,		///< Alloc and free can be called from any thread at the same time, without locks.
+}CLR_STACK_POOL_MODES;
+
+/**
+ * CLR_STACK_POOL Structure, manages a memory block passed with init as a pool of equal size slots, each one starting
+ * on a cache line, for allocating fixed size objects. Slots are identified by their index, so they can be passed through
+ * CLR_STACK queues as a small number instead of copying the whole object.
+ * Free slots are kept in a list stored inside the slots themselves, so alloc and free are O(1) and need no extra memory.
+ * YOU SHALL NOT interact with its elements, the functions given below will manage it safely.
+ * */
+typedef struct st_CLR_STACK_POOL{
+	unsigned char * slots;			///< Pointer to the first slot, the memory block aligned to a cache line
+	int slot_size;					///< Size of a slot in bytes, the object size rounded up to a whole number of cache lines
+	int slots_maximum;				///< Total number of slots in the pool
+	int mode;						///< Operation mode of the pool
+	atomic_ullong free_head;		///< First free slot in the low 32 bits, and a counter in the high 32 bits so lock-free updates detect changes
+	atomic_int slots_free;			///< Number of free slots
+}CLR_STACK_POOL;
+
+/**
+ * Returns if the passed CLR_STACK_POOL structure is empty, meaning all its slots are allocated
+ * */
+bool CLR_STACK_POOL_is_empty(CLR_STACK_POOL* P);
+
+/**
+ * Returns if the passed CLR_STACK_POOL structure is full, meaning none of its slots is allocated
+ * */
+bool CLR_STACK_POOL_is_full(CLR_STACK_POOL* P);
+
+/**
+ * Returns the number of slots that can still be allocated from the passed CLR_STACK_POOL structure
+ * */
+int CLR_STACK_POOL_get_free_slots(CLR_STACK_POOL* P);
+
+/**
+ * Returns a pointer to the slot with index index of the passed CLR_STACK_POOL structure, NULL if index is out of range
+ * */
+unsigned char * CLR_STACK_POOL_get_slot(CLR_STACK_POOL* P, int index);
+
+/**
+ * Returns the index of the slot pointed by slot (which can point anywhere inside the slot), -1 if it is not a slot of the pool
+ * */
+int CLR_STACK_POOL_get_index(CLR_STACK_POOL* P, unsigned char * slot);
+
+/**
+ * Function for set-up and start managing the memory passed in mem_chunk (of size size) in the CLR_STACK_POOL structure P
+ * as a pool of slots of object_size bytes of mode mode.
+ * This function MUST be called before any other for succesfull operation, and before any other thread uses the pool.
+ *
+ * \param P Pointer to the CLR_STACK_POOL structure that will manage te memory block
+ * \param mem_chunk pointer to the memory block that will be managed by the CLR_STACK_POOL structure
+ * \param size the size in BYTES of the memory block
+ * \param object_size the size in BYTES of the objects to allocate, slots are rounded up to whole cache lines
+ * \param mode the operation mode for the pool
+ *
+ * \returns A CLR_STACK_ERROR_CODES value.
+ * \li CLR_STACK_SUCCESS if init succesful.
+ * \li CLR_STACK_ERROR_WRONG_SIZE if object_size < 1 or the memory block can not hold a single slot.
+ * \li CLR_STACK_ERROR_WRONG_MODE if the mode passed is not included in CLR_STACK_POOL_MODES.
+ * \li CLR_STACK_ERROR_NULL_POINTER if P or mem_chunk is a NULL pointer.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_POOL_init(CLR_STACK_POOL* P, unsigned char * mem_chunk, int size, int object_size, CLR_STACK_POOL_MODES mode);
+
+/**
+ * Function for allocating a slot from a PREVIOUSLY INITIALIZED CLR_STACK_POOL Structure.
+ * The content of the slot is not cleared.
+ *
+ * \param P Pointer to the CLR_STACK_POOL structure to allocate the slot from.
+ * \param index pointer in which the index of the allocated slot will be written, use CLR_STACK_POOL_get_slot to access it.
+ *
+ * \returns A CLR_STACK_ERROR_CODES value:
+ * \li CLR_STACK_SUCCESS if alloc succesful.
+ * \li CLR_STACK_ERROR_POOL_EMPTY if all the slots are allocated.
+ * \li CLR_STACK_ERROR_NULL_POINTER if index is a NULL pointer.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_POOL_alloc(CLR_STACK_POOL* P, int * index);
+
+/**
+ * Function for giving back a slot to a PREVIOUSLY INITIALIZED CLR_STACK_POOL Structure.
+ * The slot MUST have been allocated, and MUST NOT be used after this call.
+ *
+ * \param P Pointer to the CLR_STACK_POOL structure the slot was allocated from.
+ * \param index index of the slot to give back.
+ *
+ * \returns A CLR_STACK_ERROR_CODES value:
+ * \li CLR_STACK_SUCCESS if free succesful.
+ * \li CLR_STACK_ERROR_WRONG_SIZE if index is out of range.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_POOL_free(CLR_STACK_POOL* P, int index);
+
+#endif //__CLR_STACK_POOL_H_
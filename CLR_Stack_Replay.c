@@ -0,0 +1,282 @@
+/////////////////////////////////////////////////
+//
+//	This file is part of CLR_Stack.
+//
+//	CLR_Stack is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	CLR_Stack is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with CLR_Stack.  If not, see <https://www.gnu.org/licenses/>.
+//
+/////////////////////////////////////////////////
+//
+//	Replays a trace recorded with CLR_Stack_Trace against a CLR_STACK of any mode and size, as fast as possible,
+//	reporting throughput, rejected pushes, overwritten bytes and peak occupancy.
+//
+//	Usage: CLR_Stack_Replay <trace file> <fifo|ring> <size in bytes> [repetitions]
+//
+/////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "CLR_Stack.h" //CLR stack header file must be included
+#include "CLR_Stack_Trace.h"
+
+#define RECORDS_INITIAL 4096	// Records allocated when loading a trace, the array doubles every time it gets full
+
+//Results of a replay
+typedef struct{
+	unsigned long long operations;		// Operations replayed
+	unsigned long long bytes_pushed;	// Bytes accepted by the stack
+	unsigned long long bytes_popped;	// Bytes popped from the stack
+	unsigned long long pushes_rejected;	// Pushes that returned an error
+	unsigned long long bytes_rejected;	// Bytes of the pushes that returned an error
+	unsigned long long pops_failed;		// Pops and peeks that returned an error
+	unsigned long long bytes_overwritten;	// Bytes erased by pushes in RING mode before being popped
+	int size_peak;						// Highest used space seen
+}REPLAY_RESULTS;
+
+//Returns the current time in nanoseconds
+unsigned long long time_now(void)
+{
+	struct timespec ts;
+
+	timespec_get(&ts, TIME_UTC);
+
+	return ((unsigned long long)ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+}
+
+//Loads all the records of the trace file into a newly allocated array, returns the number of records or -1 on error
+long load_trace(const char *file_name, CLR_STACK_TRACE_RECORD **records)
+{
+	FILE *file = NULL;
+	CLR_STACK_TRACE_RECORD *array = NULL;
+	CLR_STACK_TRACE_RECORD *array_grown = NULL;
+	long records_maximum = RECORDS_INITIAL;
+	long records_count = 0;
+	CLR_STACK_ERROR_CODES Error_Code = CLR_STACK_SUCCESS;
+
+	file = fopen(file_name, "rb");
+	if (file == NULL)
+	{
+		printf("ERROR: Can not open %s\n", file_name);
+		return -1;
+	}
+
+	if (CLR_STACK_TRACE_load_header(file) != CLR_STACK_SUCCESS)
+	{
+		printf("ERROR: %s is not a CLR_STACK trace, or its version is not supported\n", file_name);
+		fclose(file);
+		return -1;
+	}
+
+	array = malloc(records_maximum * sizeof(CLR_STACK_TRACE_RECORD));
+
+	while (array != NULL)
+	{
+		if (records_count == records_maximum)
+		{
+			records_maximum = records_maximum << 1;
+			array_grown = realloc(array, records_maximum * sizeof(CLR_STACK_TRACE_RECORD));
+			if (array_grown == NULL)
+				free(array);
+			array = array_grown;
+		}
+		else
+		{
+			Error_Code = CLR_STACK_TRACE_load_record(file, &array[records_count]);
+			if (Error_Code != CLR_STACK_SUCCESS)
+				break;
+			records_count++;
+		}
+	}
+
+	fclose(file);
+
+	if (array == NULL)
+	{
+		printf("ERROR: Not enough memory to load the trace\n");
+		return -1;
+	}
+	if (Error_Code == CLR_STACK_ERROR_WRONG_MODE)
+	{
+		//A trace cut while being saved still has all the records before the cut
+		printf("WARNING: Invalid record %ld, the trace is replayed up to it\n", records_count);
+	}
+
+	*records = array;
+
+	return records_count;
+}
+
+//Replays all the records on S, adding the results to results
+void replay(CLR_STACK *S, CLR_STACK_TRACE_RECORD *records, long records_count, unsigned char *data, REPLAY_RESULTS *results)
+{
+	long i = 0;
+	int size = 0;
+	int size_used = 0;
+
+	for (i = 0; i < records_count; i++)
+	{
+		size = (int)records[i].size;
+
+		switch (records[i].operation)
+		{
+		case CLR_STACK_TRACE_PUSH:
+			size_used = CLR_STACK_get_used_space(S);
+			if (CLR_STACK_push(S, data, size) == CLR_STACK_SUCCESS)
+			{
+				results->bytes_pushed += size;
+				if ((size_used + size) > S->size_maximum)
+					results->bytes_overwritten += (size_used + size) - S->size_maximum;
+			}
+			else
+			{
+				results->pushes_rejected++;
+				results->bytes_rejected += size;
+			}
+			if (CLR_STACK_get_used_space(S) > results->size_peak)
+				results->size_peak = CLR_STACK_get_used_space(S);
+			break;
+		case CLR_STACK_TRACE_POP:
+			if (CLR_STACK_pop(S, data, size) == CLR_STACK_SUCCESS)
+				results->bytes_popped += size;
+			else
+				results->pops_failed++;
+			break;
+		case CLR_STACK_TRACE_PEEK:
+			if (CLR_STACK_peek(S, data, size) != CLR_STACK_SUCCESS)
+				results->pops_failed++;
+			break;
+		default:
+			break;
+		}
+	}
+
+	results->operations += records_count;
+}
+
+int main(int argc, char *argv[])
+{
+	CLR_STACK_TRACE_RECORD *records = NULL;
+	long records_count = 0;
+	long i = 0;
+
+	//Figures of the trace as it was recorded
+	unsigned long long trace_duration = 0;
+	unsigned long long trace_failed = 0;
+	unsigned int trace_threads = 0;
+	unsigned int size_largest = 1;
+
+	CLR_STACK_OPERATION_MODES Chosen_mode;
+	int Chosen_size = 0;
+	int repetitions = 1;
+
+	unsigned char *memory = NULL;
+	unsigned char *data = NULL;
+	CLR_STACK CLR_STACK_STR;
+	CLR_STACK_ERROR_CODES Error_Code;
+
+	REPLAY_RESULTS results;
+	unsigned long long time_start = 0;
+	double seconds = 0;
+
+	if ((argc < 4) || (argc > 5))
+	{
+		printf("Usage: %s <trace file> <fifo|ring> <size in bytes> [repetitions]\n", argv[0]);
+		return 1;
+	}
+
+	if (strcmp(argv[2], "fifo") == 0)
+		Chosen_mode = CLR_STACK_MODE_FIFO;
+	else if (strcmp(argv[2], "ring") == 0)
+		Chosen_mode = CLR_STACK_MODE_RING;
+	else
+	{
+		printf("ERROR: Unknown mode %s, use fifo or ring\n", argv[2]);
+		return 1;
+	}
+
+	Chosen_size = atoi(argv[3]);
+	if (argc == 5)
+		repetitions = atoi(argv[4]);
+	if ((Chosen_size < 1) || (repetitions < 1))
+	{
+		printf("ERROR: Size and repetitions must be bigger than 0\n");
+		return 1;
+	}
+
+	records_count = load_trace(argv[1], &records);
+	if (records_count < 0)
+		return 1;
+
+	for (i = 0; i < records_count; i++)
+	{
+		trace_duration += records[i].time_delta;
+		if (records[i].failed)
+			trace_failed++;
+		if (records[i].thread >= trace_threads)
+			trace_threads = records[i].thread + 1;
+		if (records[i].size > size_largest)
+			size_largest = records[i].size;
+	}
+
+	printf("Trace %s: %ld operations, %llu failed when recorded, %u thread ids, %llu time units long\n",
+			argv[1], records_count, trace_failed, trace_threads, trace_duration);
+
+	memory = malloc(Chosen_size);
+	data = calloc(size_largest, 1);
+	if ((memory == NULL) || (data == NULL))
+	{
+		printf("ERROR: Not enough memory for a stack of %d bytes\n", Chosen_size);
+		return 1;
+	}
+
+	memset(&results, 0, sizeof(results));
+
+	time_start = time_now();
+	for (i = 0; i < repetitions; i++)
+	{
+		//Every repetition starts with an empty stack, as the trace did
+		Error_Code = CLR_STACK_init(&CLR_STACK_STR, memory, Chosen_size, Chosen_mode);
+		if (Error_Code != CLR_STACK_SUCCESS)
+		{
+			printf("Error %d while initializing the memory block, check the declaration of CLR_STACK_ERROR_CODES for more info!\n", Error_Code);
+			return Error_Code;
+		}
+
+		replay(&CLR_STACK_STR, records, records_count, data, &results);
+	}
+	seconds = (time_now() - time_start) / 1e9;
+
+	printf("Replay on a %s stack of %d bytes, %d repetitions:\n", argv[2], Chosen_size, repetitions);
+	printf("----------------------\n");
+	printf("Time:               %.6f s\n", seconds);
+	if (seconds > 0)
+	{
+		printf("Throughput:         %.0f operations/s, %.2f MB/s pushed\n", results.operations / seconds, results.bytes_pushed / seconds / 1e6);
+	}
+	printf("Bytes pushed:       %llu\n", results.bytes_pushed);
+	printf("Bytes popped:       %llu\n", results.bytes_popped);
+	printf("Rejected pushes:    %llu (%llu bytes)\n", results.pushes_rejected, results.bytes_rejected);
+	printf("Failed pops/peeks:  %llu\n", results.pops_failed);
+	printf("Overwritten bytes:  %llu\n", results.bytes_overwritten);
+	printf("Peak occupancy:     %d bytes (%.1f%%)\n", results.size_peak, (100.0 * results.size_peak) / Chosen_size);
+
+	free(data);
+	free(memory);
+	free(records);
+
+	return 0;
+}
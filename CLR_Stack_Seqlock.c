@@ -0,0 +1,156 @@
+/////////////////////////////////////////////////
+//
+//	This file is part of CLR_Stack.
+//
+//	CLR_Stack is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	CLR_Stack is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with CLR_Stack.  If not, see <https://www.gnu.org/licenses/>.
+//
+/////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "CLR_Stack_Seqlock.h"
+
+//Copies size bytes starting at the position given by the total bytes pushed before them. Only memory_chunk and size_maximum
+//are read from the stack, as they do not change after init.
+void CLR_STACK_SEQLOCK_copy(CLR_STACK_SEQLOCK* S, unsigned long long start, unsigned char * bytes, int size){
+	int offset = (int)(start % (unsigned long long)S->stack.size_maximum);
+	int remaining_size_before_end = S->stack.size_maximum - offset;
+
+	if(size <= remaining_size_before_end){
+		memcpy(bytes, &S->stack.memory_chunk[offset], size);
+	}
+	else{
+		memcpy(bytes, &S->stack.memory_chunk[offset], remaining_size_before_end);
+		memcpy(&bytes[remaining_size_before_end], S->stack.memory_chunk, size - remaining_size_before_end);
+	}
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_SEQLOCK_init(CLR_STACK_SEQLOCK* S, unsigned char * mem_chunk, int size){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+
+	if(S != 0){
+		if(((uintptr_t)S % _Alignof(CLR_STACK_SEQLOCK)) != 0){
+			ret = CLR_STACK_ERROR_WRONG_ALIGNMENT;
+		}
+		else{
+			ret = CLR_STACK_init(&S->stack, mem_chunk, size, CLR_STACK_MODE_RING);
+
+			atomic_init(&S->bytes_claimed, 0);
+			atomic_init(&S->bytes_committed, 0);
+		}
+	}
+	else
+		ret = CLR_STACK_ERROR_NULL_POINTER;
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_SEQLOCK_push(CLR_STACK_SEQLOCK* S, unsigned char * bytes, int size){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+	unsigned long long bytes_pushed = 0;
+
+	if (bytes != 0)
+	{
+		if ((size > 0) && (size <= S->stack.size_maximum))
+		{
+			//Only this thread writes the counters, so a relaxed load of its own value is enough
+			bytes_pushed = atomic_load_explicit(&S->bytes_committed, memory_order_relaxed) + size;
+
+			//Readers that see the new claimed value after copying know their copy may be overwritten
+			atomic_store_explicit(&S->bytes_claimed, bytes_pushed, memory_order_relaxed);
+			atomic_thread_fence(memory_order_release);
+
+			ret = CLR_STACK_push(&S->stack, bytes, size);
+
+			atomic_store_explicit(&S->bytes_committed, bytes_pushed, memory_order_release);
+		}
+		else
+			ret = CLR_STACK_ERROR_PUT_NOT_ENOUGH_SPACE;
+	}
+	else
+		ret = CLR_STACK_ERROR_NULL_POINTER;
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_SEQLOCK_read_latest(CLR_STACK_SEQLOCK* S, unsigned char * bytes, int size, int * size_read, int * size_lost){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+	unsigned long long committed = 0;
+	unsigned long long claimed = 0;
+	unsigned long long oldest_valid = 0;
+	unsigned long long start = 0;
+	int count = 0;
+	int lost = 0;
+	int retries = 0;
+
+	if ((bytes != 0) && (size_read != 0))
+	{
+		if (size > 0)
+		{
+			do
+			{
+				committed = atomic_load_explicit(&S->bytes_committed, memory_order_acquire);
+
+				count = size;
+				if (count > S->stack.size_maximum)
+					count = S->stack.size_maximum;
+				if ((unsigned long long)count > committed)
+					count = (int)committed;
+				start = committed - count;
+
+				CLR_STACK_SEQLOCK_copy(S, start, bytes, count);
+
+				//Anything older than the last size_maximum bytes claimed by the writer may have been overwritten during the copy
+				atomic_thread_fence(memory_order_acquire);
+				claimed = atomic_load_explicit(&S->bytes_claimed, memory_order_relaxed);
+				oldest_valid = 0;
+				if (claimed > (unsigned long long)S->stack.size_maximum)
+					oldest_valid = claimed - S->stack.size_maximum;
+
+				lost = 0;
+				if (oldest_valid > start)
+				{
+					if ((oldest_valid - start) < (unsigned long long)count)
+						lost = (int)(oldest_valid - start);
+					else
+						lost = count;
+				}
+
+				retries++;
+			} while ((lost > 0) && (retries <= CLR_STACK_SEQLOCK_READ_RETRIES));
+
+			//Keep only the newest bytes, which the writer did not reach
+			if ((lost > 0) && (lost < count))
+				memmove(bytes, &bytes[lost], count - lost);
+
+			*size_read = count - lost;
+			if (size_lost != 0)
+				*size_lost = lost;
+
+			if (*size_read > 0)
+				ret = CLR_STACK_SUCCESS;
+			else
+				ret = CLR_STACK_ERROR_POP_NOT_ENOUGH_BYTES;
+		}
+		else
+			ret = CLR_STACK_ERROR_WRONG_SIZE;
+	}
+	else
+		ret = CLR_STACK_ERROR_NULL_POINTER;
+
+	return ret;
+}
@@ -0,0 +1,102 @@
+/////////////////////////////////////////////////
+//
+//	This file is part of CLR_Stack.
+//
+//	CLR_Stack is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	CLR_Stack is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with CLR_Stack.  If not, see <https://www.gnu.org/licenses/>.
+//
+/////////////////////////////////////////////////
+
+#ifndef __CLR_STACK_SEQLOCK_H_
+#define __CLR_STACK_SEQLOCK_H_
+
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "CLR_Stack.h"
+
+/**
+ * Number of times CLR_STACK_SEQLOCK_read_latest copies the data again when the writer overwrote part of it during the copy.
+ * Define it before including this file to change it.
+ * */
+#ifndef CLR_STACK_SEQLOCK_READ_RETRIES
+#define CLR_STACK_SEQLOCK_READ_RETRIES 3
+#endif
+
+/**
+ * CLR_STACK_SEQLOCK Structure, a RING mode CLR_STACK with a single writer and any number of lossy readers.
+ * The writer never waits for the readers: it publishes how many bytes it has claimed and committed, and readers copy the
+ * latest data without any lock, checking afterwards if the writer lapped them during the copy.
+ * The writer is wait-free as long as 64 bit atomics are lock-free in the target.
+ * The structure MUST be aligned to CLR_STACK_CACHE_LINE_SIZE: declare it statically (or on the stack), or allocate it
+ * with aligned_alloc. malloc only guarantees the alignment of max_align_t, which is usually smaller.
+ * YOU SHALL NOT interact with its elements, the functions given below will manage it safely.
+ * */
+typedef struct st_CLR_STACK_SEQLOCK{
+	CLR_STACK stack;								///< RING mode stack holding the data, only modified by the writer
+	_Alignas(CLR_STACK_CACHE_LINE_SIZE) atomic_ullong bytes_claimed;	///< Total bytes pushed, counting the push in progress
+	atomic_ullong bytes_committed;					///< Total bytes pushed and completely written
+}CLR_STACK_SEQLOCK;
+
+/**
+ * Function for set-up and start managing the memory passed in mem_chunk (of size size) in the CLR_STACK_SEQLOCK structure S
+ * as a ring buffer. This function MUST be called before any other for succesfull operation, and before any reader uses it.
+ *
+ * \param S Pointer to the CLR_STACK_SEQLOCK structure that will manage te memory block
+ * \param mem_chunk pointer to the memory block that will be managed by the CLR_STACK_SEQLOCK structure
+ * \param size the size in BYTES of the memory block
+ *
+ * \returns A CLR_STACK_ERROR_CODES value, the same ones as CLR_STACK_init, and:
+ * \li CLR_STACK_ERROR_WRONG_ALIGNMENT if S is not aligned to CLR_STACK_CACHE_LINE_SIZE.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_SEQLOCK_init(CLR_STACK_SEQLOCK* S, unsigned char * mem_chunk, int size);
+
+/**
+ * Function for putting data in a PREVIOUSLY INITIALIZED CLR_STACK_SEQLOCK Structure. Older data is erased to make space.
+ * Only one thread may push into a CLR_STACK_SEQLOCK.
+ *
+ * \param S Pointer to the CLR_STACK_SEQLOCK structure to put data into.
+ * \param bytes pointer to the memory block to put in the stack
+ * \param size the size in BYTES of the memory block to put.
+ *
+ * \returns A CLR_STACK_ERROR_CODES value:
+ * \li CLR_STACK_SUCCESS if push succesful.
+ * \li CLR_STACK_ERROR_PUT_NOT_ENOUGH_SPACE if size < 1 or size > size_maximum.
+ * \li CLR_STACK_ERROR_NULL_POINTER if bytes is a NULL pointer.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_SEQLOCK_push(CLR_STACK_SEQLOCK* S, unsigned char * bytes, int size);
+
+/**
+ * Function for copying the latest size bytes pushed in a PREVIOUSLY INITIALIZED CLR_STACK_SEQLOCK Structure, from any thread.
+ * Nothing is taken out and the writer is never slowed down. If the writer overwrites part of the data during the copy,
+ * the copy is done again up to CLR_STACK_SEQLOCK_READ_RETRIES times; after that the overwritten (oldest) bytes are dropped
+ * and only the newest ones, still valid, are returned.
+ *
+ * \param S Pointer to the CLR_STACK_SEQLOCK structure to read data from.
+ * \param bytes pointer to the memory block in which the data will be written, the oldest byte first.
+ * \param size the amount of bytes to read, it must be equal or smaller than the "bytes" memory block.
+ * \param size_read pointer in which the number of valid bytes written in "bytes" will be written.
+ * \param size_lost pointer in which the number of bytes dropped because the writer overwrote them will be written, can be NULL.
+ *
+ * \returns A CLR_STACK_ERROR_CODES value:
+ * \li CLR_STACK_SUCCESS if data was read, size_read may be smaller than size if less data was pushed or some was lost.
+ * \li CLR_STACK_ERROR_POP_NOT_ENOUGH_BYTES if nothing was pushed yet or all the data was lost.
+ * \li CLR_STACK_ERROR_WRONG_SIZE if size < 1.
+ * \li CLR_STACK_ERROR_NULL_POINTER if bytes or size_read is a NULL pointer.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_SEQLOCK_read_latest(CLR_STACK_SEQLOCK* S, unsigned char * bytes, int size, int * size_read, int * size_lost);
+
+#endif //__CLR_STACK_SEQLOCK_H_
@@ -0,0 +1,192 @@
+/////////////////////////////////////////////////
+//
+//	This file is part of CLR_Stack.
+//
+//	CLR_Stack is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	CLR_Stack is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with CLR_Stack.  If not, see <https://www.gnu.org/licenses/>.
+//
+/////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "CLR_Stack_Sharded.h"
+
+void CLR_STACK_SHARDED_lock(CLR_STACK_SHARD * shard){
+	while(atomic_flag_test_and_set_explicit(&shard->lock, memory_order_acquire))
+		;
+}
+
+void CLR_STACK_SHARDED_unlock(CLR_STACK_SHARD * shard){
+	atomic_flag_clear_explicit(&shard->lock, memory_order_release);
+}
+
+//Pops up to items_maximum items from a shard, returns the number of items popped
+int CLR_STACK_SHARDED_take(CLR_STACK_SHARDED* S, CLR_STACK_SHARD * shard, unsigned char * bytes, int items_maximum){
+	int items = 0;
+
+	CLR_STACK_SHARDED_lock(shard);
+
+	items = CLR_STACK_get_used_space(&shard->stack) / S->item_size;
+	if(items > items_maximum)
+		items = items_maximum;
+
+	if((items > 0) && (CLR_STACK_pop(&shard->stack, bytes, items * S->item_size) == CLR_STACK_SUCCESS))
+		atomic_store_explicit(&shard->items_current, CLR_STACK_get_used_space(&shard->stack) / S->item_size, memory_order_relaxed);
+	else
+		items = 0;
+
+	CLR_STACK_SHARDED_unlock(shard);
+
+	return items;
+}
+
+bool CLR_STACK_SHARDED_is_empty(CLR_STACK_SHARDED* S){
+	bool ret = true;
+	int i = 0;
+
+	for(i = 0; (i < S->shards_count) && (ret == true); i++){
+		if(atomic_load_explicit(&S->shards[i].items_current, memory_order_relaxed) > 0)
+			ret = false;
+	}
+
+	return ret;
+}
+
+int CLR_STACK_SHARDED_get_used_items(CLR_STACK_SHARDED* S){
+	int ret = 0;
+	int i = 0;
+
+	for(i = 0; i < S->shards_count; i++)
+		ret = ret + atomic_load_explicit(&S->shards[i].items_current, memory_order_relaxed);
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_SHARDED_init(CLR_STACK_SHARDED* S, CLR_STACK_SHARD * shards, int shards_count, unsigned char * mem_chunk, int size, int item_size){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+	int shard_size = 0;
+	int i = 0;
+
+	if((S != 0) && (shards != 0) && (mem_chunk != 0)){
+		if((shards_count > 0) && (item_size > 0))
+			shard_size = ((size / shards_count) / item_size) * item_size;
+
+		if(((uintptr_t)shards % _Alignof(CLR_STACK_SHARD)) != 0){
+			ret = CLR_STACK_ERROR_WRONG_ALIGNMENT;
+		}
+		else if(shard_size > 0){
+			S->shards = shards;
+			S->shards_count = shards_count;
+			S->item_size = item_size;
+
+			ret = CLR_STACK_SUCCESS;
+			for(i = 0; (i < shards_count) && (ret == CLR_STACK_SUCCESS); i++){
+				atomic_flag_clear(&shards[i].lock);
+				atomic_init(&shards[i].items_current, 0);
+				ret = CLR_STACK_init(&shards[i].stack, &mem_chunk[i * shard_size], shard_size, CLR_STACK_MODE_FIFO);
+			}
+		}
+		else
+			ret = CLR_STACK_ERROR_WRONG_SIZE;
+	}
+	else
+		ret = CLR_STACK_ERROR_NULL_POINTER;
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_SHARDED_push(CLR_STACK_SHARDED* S, int shard, unsigned char * bytes, int items){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+	CLR_STACK_SHARD * local = 0;
+
+	if (bytes != 0)
+	{
+		if ((shard >= 0) && (shard < S->shards_count) && (items > 0))
+		{
+			local = &S->shards[shard];
+
+			CLR_STACK_SHARDED_lock(local);
+			ret = CLR_STACK_push(&local->stack, bytes, items * S->item_size);
+			if (ret == CLR_STACK_SUCCESS)
+				atomic_store_explicit(&local->items_current, CLR_STACK_get_used_space(&local->stack) / S->item_size, memory_order_relaxed);
+			CLR_STACK_SHARDED_unlock(local);
+		}
+		else
+			ret = CLR_STACK_ERROR_WRONG_SIZE;
+	}
+	else
+		ret = CLR_STACK_ERROR_NULL_POINTER;
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_SHARDED_pop(CLR_STACK_SHARDED* S, int shard, unsigned char * bytes, int items_maximum, int * items_popped){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+	int items = 0;
+	int victim = -1;
+	int victim_items = 0;
+	int shard_items = 0;
+	int i = 0;
+
+	if ((bytes != 0) && (items_popped != 0))
+	{
+		if ((shard >= 0) && (shard < S->shards_count) && (items_maximum > 0))
+		{
+			if (atomic_load_explicit(&S->shards[shard].items_current, memory_order_relaxed) > 0)
+				items = CLR_STACK_SHARDED_take(S, &S->shards[shard], bytes, items_maximum);
+
+			//Own shard is empty, steal from the fullest other shard. Look again if other consumers emptied it first.
+			while ((items == 0) && (victim_items >= 0))
+			{
+				victim = -1;
+				victim_items = 0;
+				for (i = 0; i < S->shards_count; i++)
+				{
+					shard_items = atomic_load_explicit(&S->shards[i].items_current, memory_order_relaxed);
+					if (shard_items > victim_items)
+					{
+						victim = i;
+						victim_items = shard_items;
+					}
+				}
+
+				if (victim >= 0)
+				{
+					//Take half of the items of the victim so it keeps working on the rest
+					victim_items = (victim_items + 1) >> 1;
+					if (victim_items > items_maximum)
+						victim_items = items_maximum;
+
+					items = CLR_STACK_SHARDED_take(S, &S->shards[victim], bytes, victim_items);
+				}
+				else
+					victim_items = -1;
+			}
+
+			*items_popped = items;
+
+			if (items > 0)
+				ret = CLR_STACK_SUCCESS;
+			else
+				ret = CLR_STACK_ERROR_POP_NOT_ENOUGH_BYTES;
+		}
+		else
+			ret = CLR_STACK_ERROR_WRONG_SIZE;
+	}
+	else
+		ret = CLR_STACK_ERROR_NULL_POINTER;
+
+	return ret;
+}
@@ -0,0 +1,123 @@
+/////////////////////////////////////////////////
+//
+//	This file is part of CLR_Stack.
+//
+//	CLR_Stack is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	CLR_Stack is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with CLR_Stack.  If not, see <https://www.gnu.org/licenses/>.
+//
+/////////////////////////////////////////////////
+
+#ifndef __CLR_STACK_SHARDED_H_
+#define __CLR_STACK_SHARDED_H_
+
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "CLR_Stack.h"
+
+/**
+ * One shard of a CLR_STACK_SHARDED queue: a FIFO CLR_STACK protected by its own lock.
+ * Each shard takes a whole cache line so threads working on different shards do not slow each other.
+ * Arrays of shards MUST be aligned to CLR_STACK_CACHE_LINE_SIZE: declare them statically (or on the stack), or allocate them
+ * with aligned_alloc. malloc only guarantees the alignment of max_align_t, which is usually smaller.
+ * YOU SHALL NOT interact with its elements, the functions given below will manage it safely.
+ * */
+typedef struct st_CLR_STACK_SHARD{
+	_Alignas(CLR_STACK_CACHE_LINE_SIZE) CLR_STACK stack;	///< Stack holding the items of the shard
+	atomic_flag lock;										///< Spin lock protecting stack
+	atomic_int items_current;								///< Copy of the number of items in stack, readable without taking the lock
+}CLR_STACK_SHARD;
+
+/**
+ * CLR_STACK_SHARDED Structure, manages a memory block passed with init as a queue of fixed size items split in shards,
+ * one per core or thread. Producers push into their own shard and consumers pop from their own shard,
+ * stealing a batch of items from the fullest other shard when their own is empty.
+ * YOU SHALL NOT interact with its elements, the functions given below will manage it safely.
+ * */
+typedef struct st_CLR_STACK_SHARDED{
+	CLR_STACK_SHARD * shards;	///< Array of shards, passed in the init function
+	int shards_count;			///< Number of shards in the array
+	int item_size;				///< Size of a single item in bytes, configured in the init function
+}CLR_STACK_SHARDED;
+
+/**
+ * Returns if all the shards of the passed CLR_STACK_SHARDED structure are empty.
+ * No shard is locked, so with other threads working on the queue the result is only a snapshot.
+ * */
+bool CLR_STACK_SHARDED_is_empty(CLR_STACK_SHARDED* S);
+
+/**
+ * Returns the number of items stored in all the shards of the passed CLR_STACK_SHARDED structure.
+ * No shard is locked, so with other threads working on the queue the result is only a snapshot.
+ * */
+int CLR_STACK_SHARDED_get_used_items(CLR_STACK_SHARDED* S);
+
+/**
+ * Function for set-up and start managing the memory passed in mem_chunk (of size size) in the CLR_STACK_SHARDED structure S
+ * as shards_count FIFO stacks of items of item_size bytes. The memory block is split evenly between the shards.
+ * This function MUST be called before any other for succesfull operation, and before any other thread uses the queue.
+ *
+ * \param S Pointer to the CLR_STACK_SHARDED structure that will manage te memory block
+ * \param shards array of shards_count CLR_STACK_SHARD structures, aligned to CLR_STACK_CACHE_LINE_SIZE, it must live as long as S is used
+ * \param shards_count number of shards, usually the number of cores or threads using the queue
+ * \param mem_chunk pointer to the memory block that will be managed by the CLR_STACK_SHARDED structure
+ * \param size the size in BYTES of the memory block
+ * \param item_size the size in BYTES of every item
+ *
+ * \returns A CLR_STACK_ERROR_CODES value.
+ * \li CLR_STACK_SUCCESS if init succesful.
+ * \li CLR_STACK_ERROR_WRONG_SIZE if shards_count < 1, item_size < 1 or the memory block can not hold an item per shard.
+ * \li CLR_STACK_ERROR_WRONG_ALIGNMENT if shards is not aligned to CLR_STACK_CACHE_LINE_SIZE.
+ * \li CLR_STACK_ERROR_NULL_POINTER if S, shards or mem_chunk is a NULL pointer.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_SHARDED_init(CLR_STACK_SHARDED* S, CLR_STACK_SHARD * shards, int shards_count, unsigned char * mem_chunk, int size, int item_size);
+
+/**
+ * Function for putting items in the shard of the calling thread of a PREVIOUSLY INITIALIZED CLR_STACK_SHARDED Structure.
+ *
+ * \param S Pointer to the CLR_STACK_SHARDED structure to put the items into.
+ * \param shard index of the shard of the calling thread, in the range [0, shards_count).
+ * \param bytes pointer to the items to put in the queue.
+ * \param items number of items to put, items * item_size bytes will be copied.
+ *
+ * \returns A CLR_STACK_ERROR_CODES value:
+ * \li CLR_STACK_SUCCESS if push succesful.
+ * \li CLR_STACK_ERROR_WRONG_SIZE if shard is out of range or items < 1.
+ * \li CLR_STACK_ERROR_PUT_NOT_ENOUGH_SPACE if the shard has no space for all the items, none is pushed.
+ * \li CLR_STACK_ERROR_NULL_POINTER if bytes is a NULL pointer.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_SHARDED_push(CLR_STACK_SHARDED* S, int shard, unsigned char * bytes, int items);
+
+/**
+ * Function for popping items from a PREVIOUSLY INITIALIZED CLR_STACK_SHARDED Structure.
+ * Items are taken from the shard of the calling thread. If it is empty, up to half of the items of the fullest
+ * other shard are stolen in one go, so idle consumers do not come back for every single item.
+ *
+ * \param S Pointer to the CLR_STACK_SHARDED structure to pop the items from.
+ * \param shard index of the shard of the calling thread, in the range [0, shards_count).
+ * \param bytes pointer to the memory block in which the popped items will be written.
+ * \param items_maximum the maximum number of items to pop, "bytes" must hold at least items_maximum * item_size bytes.
+ * \param items_popped pointer in which the number of items popped will be written.
+ *
+ * \returns A CLR_STACK_ERROR_CODES value:
+ * \li CLR_STACK_SUCCESS if at least one item was popped.
+ * \li CLR_STACK_ERROR_WRONG_SIZE if shard is out of range or items_maximum < 1.
+ * \li CLR_STACK_ERROR_POP_NOT_ENOUGH_BYTES if no item was found in any shard.
+ * \li CLR_STACK_ERROR_NULL_POINTER if bytes or items_popped is a NULL pointer.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_SHARDED_pop(CLR_STACK_SHARDED* S, int shard, unsigned char * bytes, int items_maximum, int * items_popped);
+
+#endif //__CLR_STACK_SHARDED_H_
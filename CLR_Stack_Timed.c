@@ -0,0 +1,244 @@
+/////////////////////////////////////////////////
+//
+//	This file is part of CLR_Stack.
+//
+//	CLR_Stack is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	CLR_Stack is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with CLR_Stack.  If not, see <https://www.gnu.org/licenses/>.
+//
+/////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "CLR_Stack_Timed.h"
+
+bool CLR_STACK_TIMED_is_empty(CLR_STACK_TIMED* S){
+	return (S->records_current == 0);
+}
+
+bool CLR_STACK_TIMED_is_full(CLR_STACK_TIMED* S){
+	return (S->records_current == S->records_maximum);
+}
+
+int CLR_STACK_TIMED_get_used_records(CLR_STACK_TIMED* S){
+	return (S->records_current);
+}
+
+int CLR_STACK_TIMED_get_free_records(CLR_STACK_TIMED* S){
+	return (S->records_maximum - S->records_current);
+}
+
+//Translates the position of a record counted from the oldest one into its position in memory
+int CLR_STACK_TIMED_get_index(CLR_STACK_TIMED* S, int position){
+	int index = S->index_read + position;
+
+	if(index >= S->records_maximum)
+		index = index - S->records_maximum;
+
+	return index;
+}
+
+//Returns the position (counted from the oldest record) of the first record with a timestamp newer than timestamp,
+//or equal to it if include_equal is true. Returns records_current if there is none.
+int CLR_STACK_TIMED_search(CLR_STACK_TIMED* S, CLR_STACK_TIMESTAMP timestamp, bool include_equal){
+	int low = 0;
+	int high = S->records_current;
+	int middle = 0;
+	CLR_STACK_TIMESTAMP middle_timestamp;
+
+	while(low < high){
+		middle = low + ((high - low) >> 1);
+		middle_timestamp = S->timestamps[CLR_STACK_TIMED_get_index(S, middle)];
+		if((middle_timestamp < timestamp) || ((include_equal == false) && (middle_timestamp == timestamp)))
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	return low;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_TIMED_init(CLR_STACK_TIMED* S, unsigned char * mem_chunk, int size, int record_size, CLR_STACK_OPERATION_MODES mode){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+	int misalignment = 0;
+
+	if((S != 0) && (mem_chunk != 0)){
+		//Timestamps are accessed directly, so their area must start aligned to their type
+		misalignment = (int)((uintptr_t)mem_chunk % sizeof(CLR_STACK_TIMESTAMP));
+		if(misalignment != 0)
+			misalignment = sizeof(CLR_STACK_TIMESTAMP) - misalignment;
+
+		if((record_size > 0) && ((size - misalignment) >= (int)(record_size + sizeof(CLR_STACK_TIMESTAMP)))){
+			if (mode > 0 && mode < 3)
+			{
+				S->record_size = record_size;
+				S->records_maximum = (size - misalignment) / (record_size + sizeof(CLR_STACK_TIMESTAMP));
+				S->timestamps = (CLR_STACK_TIMESTAMP *)(mem_chunk + misalignment);
+				S->records = (unsigned char *)&S->timestamps[S->records_maximum];
+
+				S->records_current = 0;
+				S->index_read = 0;
+				S->index_write = 0;
+
+				memset(mem_chunk, 0, size);
+
+				S->mode = mode;
+
+				ret = CLR_STACK_SUCCESS;
+			}
+			else
+				ret = CLR_STACK_ERROR_WRONG_MODE;
+		}
+		else
+			ret = CLR_STACK_ERROR_WRONG_SIZE;
+	}
+	else
+		ret = CLR_STACK_ERROR_NULL_POINTER;
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_TIMED_push(CLR_STACK_TIMED* S, CLR_STACK_TIMESTAMP timestamp, unsigned char * bytes){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+	int index_newest = 0;
+
+	if (bytes != 0)
+	{
+		if ((S->mode == CLR_STACK_MODE_RING) || (CLR_STACK_TIMED_is_full(S) == false))
+		{
+			index_newest = CLR_STACK_TIMED_get_index(S, S->records_current - 1);
+
+			if (CLR_STACK_TIMED_is_empty(S) || (S->timestamps[index_newest] <= timestamp))
+			{
+				S->timestamps[S->index_write] = timestamp;
+				memcpy(&S->records[S->index_write * S->record_size], bytes, S->record_size);
+
+				S->index_write++;
+				if (S->index_write >= S->records_maximum)
+					S->index_write = 0;
+
+				//In RING mode a full stack loses its oldest record
+				if (CLR_STACK_TIMED_is_full(S))
+					S->index_read = S->index_write;
+				else
+					S->records_current++;
+
+				ret = CLR_STACK_SUCCESS;
+			}
+			else
+				ret = CLR_STACK_ERROR_TIMESTAMP_ORDER;
+		}
+		else
+			ret = CLR_STACK_ERROR_PUT_NOT_ENOUGH_SPACE;
+	}
+	else
+		ret = CLR_STACK_ERROR_NULL_POINTER;
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_TIMED_pop(CLR_STACK_TIMED* S, CLR_STACK_TIMESTAMP * timestamp, unsigned char * bytes){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+
+	if (bytes != 0)
+	{
+		if (CLR_STACK_TIMED_is_empty(S) == false)
+		{
+			if (timestamp != 0)
+				*timestamp = S->timestamps[S->index_read];
+			memcpy(bytes, &S->records[S->index_read * S->record_size], S->record_size);
+
+			S->index_read++;
+			if (S->index_read >= S->records_maximum)
+				S->index_read = 0;
+
+			S->records_current--;
+
+			ret = CLR_STACK_SUCCESS;
+		}
+		else
+			ret = CLR_STACK_ERROR_POP_NOT_ENOUGH_BYTES;
+	}
+	else
+		ret = CLR_STACK_ERROR_NULL_POINTER;
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_TIMED_query(CLR_STACK_TIMED* S, CLR_STACK_TIMESTAMP from, CLR_STACK_TIMESTAMP to, CLR_STACK_TIMED_SPAN * span){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+	int first = 0;
+	int last = 0;
+	int index_first = 0;
+	int records_before_end = 0;
+
+	if (span != 0)
+	{
+		memset(span, 0, sizeof(CLR_STACK_TIMED_SPAN));
+
+		if (from <= to)
+		{
+			first = CLR_STACK_TIMED_search(S, from, true);
+			last = CLR_STACK_TIMED_search(S, to, false);
+			span->count_total = last - first;
+		}
+
+		if (span->count_total > 0)
+		{
+			index_first = CLR_STACK_TIMED_get_index(S, first);
+			records_before_end = S->records_maximum - index_first;
+
+			span->timestamps[0] = &S->timestamps[index_first];
+			span->records[0] = &S->records[index_first * S->record_size];
+
+			if (span->count_total <= records_before_end)
+			{
+				span->count[0] = span->count_total;
+			}
+			else
+			{
+				span->count[0] = records_before_end;
+				span->timestamps[1] = S->timestamps;
+				span->records[1] = S->records;
+				span->count[1] = span->count_total - records_before_end;
+			}
+		}
+
+		ret = CLR_STACK_SUCCESS;
+	}
+	else
+		ret = CLR_STACK_ERROR_NULL_POINTER;
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_TIMED_evict_older(CLR_STACK_TIMED* S, CLR_STACK_TIMESTAMP timestamp, int * evicted){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+	int count = 0;
+
+	count = CLR_STACK_TIMED_search(S, timestamp, true);
+
+	if (count > 0)
+	{
+		S->index_read = CLR_STACK_TIMED_get_index(S, count);
+		S->records_current = S->records_current - count;
+	}
+
+	if (evicted != 0)
+		*evicted = count;
+
+	ret = CLR_STACK_SUCCESS;
+
+	return ret;
+}
@@ -0,0 +1,169 @@
+/////////////////////////////////////////////////
+//
+//	This file is part of CLR_Stack.
+//
+//	CLR_Stack is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	CLR_Stack is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with CLR_Stack.  If not, see <https://www.gnu.org/licenses/>.
+//
+/////////////////////////////////////////////////
+
+#ifndef __CLR_STACK_TIMED_H_
+#define __CLR_STACK_TIMED_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "CLR_Stack.h"
+
+/**
+ * Type used to store the timestamp of every record.
+ * Define CLR_STACK_TIMESTAMP_TYPE before including this file to use another unsigned type (a tick counter, a 64 bit time...)
+ * Timestamps are compared as plain numbers, so the counter must not wrap around while the records are in memory.
+ * */
+#ifndef CLR_STACK_TIMESTAMP_TYPE
+#define CLR_STACK_TIMESTAMP_TYPE uint32_t
+#endif
+
+typedef CLR_STACK_TIMESTAMP_TYPE CLR_STACK_TIMESTAMP;
+
+/**
+ * CLR_STACK_TIMED Structure, manages a memory block passed with init as a stack of fixed size records, each one with its timestamp.
+ * Records are kept in time order, so time range queries are solved with a binary search instead of reading the whole stack.
+ * The memory block is split in two areas: the timestamps of all the records first, then the records themselves.
+ * YOU SHALL NOT interact with its elements, the functions given below will manage it safely.
+ * */
+typedef struct st_CLR_STACK_TIMED{
+	CLR_STACK_TIMESTAMP * timestamps;	///< Pointer to the area of the memory block holding the timestamps
+	unsigned char * records;			///< Pointer to the area of the memory block holding the records
+	int record_size;					///< Size of a single record in bytes, configured in the init function
+	int records_maximum;				///< Total number of records that fit in the memory block
+	int records_current;				///< Number of records with data on them
+	int index_read;						///< Position of the oldest record
+	int index_write;					///< Position where the next record will be written
+	int mode;							///< Operation mode of the stack
+}CLR_STACK_TIMED;
+
+/**
+ * Result of a time range query. As the stack is circular the records found may be split in two contiguous areas,
+ * the first one always holds the oldest records. Pointers point directly to the memory block, no data is copied.
+ * Span data is only valid until the next push, pop or evict on the stack.
+ * */
+typedef struct st_CLR_STACK_TIMED_SPAN{
+	CLR_STACK_TIMESTAMP * timestamps[2];	///< Timestamps of the first record of each area
+	unsigned char * records[2];				///< First record of each area
+	int count[2];							///< Number of records in each area, 0 if the area is not used
+	int count_total;						///< Total number of records found
+}CLR_STACK_TIMED_SPAN;
+
+/**
+ * Returns if the passed CLR_STACK_TIMED structure is empty, meaning it has 0 records on it
+ * */
+bool CLR_STACK_TIMED_is_empty(CLR_STACK_TIMED* S);
+
+/**
+ * Returns if the passed CLR_STACK_TIMED structure is full, meaning it has no space for a new record.
+ * */
+bool CLR_STACK_TIMED_is_full(CLR_STACK_TIMED* S);
+
+/**
+ * Returns the number of records stored in the passed CLR_STACK_TIMED stack
+ * */
+int CLR_STACK_TIMED_get_used_records(CLR_STACK_TIMED* S);
+
+/**
+ * Returns the number of records that can still be pushed in the passed CLR_STACK_TIMED stack.
+ * Pushing more than this number will result in either an error or older records being erased, depending of the mode
+ * */
+int CLR_STACK_TIMED_get_free_records(CLR_STACK_TIMED* S);
+
+/**
+ * Function for set-up and start managing the memory passed in mem_chunk (of size size) in the CLR_STACK_TIMED structure S
+ * as a stack of records of record_size bytes of mode mode.
+ * This function MUST be called before any other for succesfull operation.
+ *
+ * \param S Pointer to the CLR_STACK_TIMED structure that will manage te memory block
+ * \param mem_chunk pointer to the memory block that will be managed by the CLR_STACK_TIMED structure
+ * \param size the size in BYTES of the memory block to set-up as a stack
+ * \param record_size the size in BYTES of every record
+ * \param mode the operation mode for the stack
+ *
+ * \returns A CLR_STACK_ERROR_CODES value.
+ * \li CLR_STACK_SUCCESS if init succesful.
+ * \li CLR_STACK_ERROR_WRONG_SIZE if record_size < 1 or the memory block can not hold a single record.
+ * \li CLR_STACK_ERROR_WRONG_MODE if the mode passed is not included in CLR_STACK_OPERATION_MODES.
+ * \li CLR_STACK_ERROR_NULL_POINTER if S or mem_chunk is a NULL pointer.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_TIMED_init(CLR_STACK_TIMED* S, unsigned char * mem_chunk, int size, int record_size, CLR_STACK_OPERATION_MODES mode);
+
+/**
+ * Function for putting a record in a PREVIOUSLY INITIALIZED CLR_STACK_TIMED Structure.
+ *
+ * \param S Pointer to the CLR_STACK_TIMED structure to put the record into.
+ * \param timestamp time of the record, it must be equal or newer than the timestamp of the last record pushed.
+ * \param bytes pointer to the record to put in the stack, record_size bytes will be copied.
+ *
+ * \returns A CLR_STACK_ERROR_CODES value:
+ * \li CLR_STACK_SUCCESS if push succesful.
+ * \li CLR_STACK_ERROR_PUT_NOT_ENOUGH_SPACE if the stack works as FIFO and it is full.
+ * \li CLR_STACK_ERROR_TIMESTAMP_ORDER if timestamp is older than the newest record in the stack.
+ * \li CLR_STACK_ERROR_NULL_POINTER if bytes is a NULL pointer.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_TIMED_push(CLR_STACK_TIMED* S, CLR_STACK_TIMESTAMP timestamp, unsigned char * bytes);
+
+/**
+ * Function for popping the oldest record from a PREVIOUSLY INITIALIZED CLR_STACK_TIMED Structure.
+ *
+ * \param S Pointer to the CLR_STACK_TIMED structure to pop the record from.
+ * \param timestamp pointer in which the timestamp of the record will be written, can be NULL if not needed.
+ * \param bytes pointer to the memory block in which the record will be written, at least record_size bytes long.
+ *
+ * \returns A CLR_STACK_ERROR_CODES value:
+ * \li CLR_STACK_SUCCESS if pop succesful.
+ * \li CLR_STACK_ERROR_POP_NOT_ENOUGH_BYTES if the stack is empty.
+ * \li CLR_STACK_ERROR_NULL_POINTER if bytes is a NULL pointer.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_TIMED_pop(CLR_STACK_TIMED* S, CLR_STACK_TIMESTAMP * timestamp, unsigned char * bytes);
+
+/**
+ * Function for finding, without taking them out, all the records with a timestamp in the range [from, to].
+ * The search is a binary search over the records, no matter how many records are stored.
+ *
+ * \param S Pointer to the CLR_STACK_TIMED structure to search in.
+ * \param from oldest timestamp included in the result.
+ * \param to newest timestamp included in the result.
+ * \param span pointer to the structure in which the areas found will be written. count_total is 0 if no record matches.
+ *
+ * \returns A CLR_STACK_ERROR_CODES value:
+ * \li CLR_STACK_SUCCESS if the search was done, even if no record was found.
+ * \li CLR_STACK_ERROR_NULL_POINTER if span is a NULL pointer.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_TIMED_query(CLR_STACK_TIMED* S, CLR_STACK_TIMESTAMP from, CLR_STACK_TIMESTAMP to, CLR_STACK_TIMED_SPAN * span);
+
+/**
+ * Function for erasing all the records older than timestamp (records with a timestamp equal to timestamp are kept).
+ *
+ * \param S Pointer to the CLR_STACK_TIMED structure to erase records from.
+ * \param timestamp oldest timestamp that will remain in the stack.
+ * \param evicted pointer in which the number of erased records will be written, can be NULL if not needed.
+ *
+ * \returns A CLR_STACK_ERROR_CODES value:
+ * \li CLR_STACK_SUCCESS always, even if no record was erased.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_TIMED_evict_older(CLR_STACK_TIMED* S, CLR_STACK_TIMESTAMP timestamp, int * evicted);
+
+#endif //__CLR_STACK_TIMED_H_
@@ -0,0 +1,257 @@
+/////////////////////////////////////////////////
+//
+//	This file is part of CLR_Stack.
+//
+//	CLR_Stack is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	CLR_Stack is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with CLR_Stack.  If not, see <https://www.gnu.org/licenses/>.
+//
+/////////////////////////////////////////////////
+
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "CLR_Stack_Trace.h"
+
+#define CLR_STACK_TRACE_FAILED_FLAG 0x10	// Bit of the first byte of a record set when the operation failed
+#define CLR_STACK_TRACE_SAVE_BLOCK 256		// Bytes moved to the file in one go by CLR_STACK_TRACE_save
+
+//The buffer is a ring with a single producer (the record functions) and a single consumer (CLR_STACK_TRACE_save).
+//Byte n (counting bytes recorded since init) is always held in position n % size_maximum. The 64 bit counters never wrap.
+
+//Writes value as a little endian base 128 varint, returns the number of bytes written
+int CLR_STACK_TRACE_encode_varint(unsigned char * bytes, unsigned long long value){
+	int ret = 0;
+
+	while(value >= 0x80){
+		bytes[ret++] = (unsigned char)(value | 0x80);
+		value = value >> 7;
+	}
+	bytes[ret++] = (unsigned char)value;
+
+	return ret;
+}
+
+//Reads a little endian base 128 varint from file, returns false if the file ends or the varint is too long
+bool CLR_STACK_TRACE_decode_varint(FILE * file, unsigned long long * value){
+	bool ret = false;
+	int c = 0;
+	int shift = 0;
+
+	*value = 0;
+	do{
+		c = fgetc(file);
+		if(c != EOF){
+			*value = *value | ((unsigned long long)(c & 0x7F) << shift);
+			shift = shift + 7;
+			ret = ((c & 0x80) == 0);
+		}
+	}while((c != EOF) && (ret == false) && (shift < 64));
+
+	return ret;
+}
+
+void CLR_STACK_TRACE_record(CLR_STACK_TRACE* T, CLR_STACK_TRACE_OPERATIONS operation, CLR_STACK_ERROR_CODES result, unsigned int thread, int size){
+	unsigned char record[CLR_STACK_TRACE_RECORD_SIZE_MAXIMUM];
+	int record_size = 0;
+	int position = 0;
+	unsigned long long time = 0;
+	unsigned long long recorded = 0;
+	unsigned long long saved = 0;
+
+	if(T->clock != 0)
+		time = T->clock();
+
+	record[record_size++] = (unsigned char)(operation | ((result != CLR_STACK_SUCCESS) ? CLR_STACK_TRACE_FAILED_FLAG : 0));
+	record_size = record_size + CLR_STACK_TRACE_encode_varint(&record[record_size], thread);
+	record_size = record_size + CLR_STACK_TRACE_encode_varint(&record[record_size], (unsigned int)size);
+	record_size = record_size + CLR_STACK_TRACE_encode_varint(&record[record_size], time - T->time_last);
+
+	recorded = atomic_load_explicit(&T->bytes_recorded, memory_order_relaxed);
+	saved = atomic_load_explicit(&T->bytes_saved, memory_order_acquire);
+
+	//A dropped record does not move time_last, so the next one carries the time of both
+	if((recorded - saved + record_size) <= (unsigned long long)T->size_maximum){
+		position = (int)(recorded % (unsigned long long)T->size_maximum);
+		if(record_size > (T->size_maximum - position)){
+			memcpy(&T->buffer[position], record, T->size_maximum - position);
+			memcpy(T->buffer, &record[T->size_maximum - position], record_size - (T->size_maximum - position));
+		}
+		else
+			memcpy(&T->buffer[position], record, record_size);
+
+		//Release, so save sees the record once it sees the new counter
+		atomic_store_explicit(&T->bytes_recorded, recorded + record_size, memory_order_release);
+		T->time_last = time;
+	}
+	else
+		atomic_fetch_add_explicit(&T->records_dropped, 1, memory_order_relaxed);
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_TRACE_init(CLR_STACK_TRACE* T, unsigned char * mem_chunk, int size, CLR_STACK_TRACE_CLOCK clock){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+
+	if((T != 0) && (mem_chunk != 0)){
+		if(((uintptr_t)T % _Alignof(CLR_STACK_TRACE)) != 0){
+			ret = CLR_STACK_ERROR_WRONG_ALIGNMENT;
+		}
+		else if(size > 0){
+			T->buffer = mem_chunk;
+			T->size_maximum = size;
+			T->clock = clock;
+			T->time_last = 0;
+			if(clock != 0)
+				T->time_last = clock();
+			T->header_saved = false;
+
+			atomic_init(&T->records_dropped, 0);
+			atomic_init(&T->bytes_recorded, 0);
+			atomic_init(&T->bytes_saved, 0);
+
+			ret = CLR_STACK_SUCCESS;
+		}
+		else
+			ret = CLR_STACK_ERROR_WRONG_SIZE;
+	}
+	else
+		ret = CLR_STACK_ERROR_NULL_POINTER;
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_TRACE_push(CLR_STACK_TRACE* T, CLR_STACK* S, unsigned int thread, unsigned char * bytes, int size){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+
+	ret = CLR_STACK_push(S, bytes, size);
+	CLR_STACK_TRACE_record(T, CLR_STACK_TRACE_PUSH, ret, thread, size);
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_TRACE_pop(CLR_STACK_TRACE* T, CLR_STACK* S, unsigned int thread, unsigned char * bytes, int size){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+
+	ret = CLR_STACK_pop(S, bytes, size);
+	CLR_STACK_TRACE_record(T, CLR_STACK_TRACE_POP, ret, thread, size);
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_TRACE_peek(CLR_STACK_TRACE* T, CLR_STACK* S, unsigned int thread, unsigned char * bytes, int size){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+
+	ret = CLR_STACK_peek(S, bytes, size);
+	CLR_STACK_TRACE_record(T, CLR_STACK_TRACE_PEEK, ret, thread, size);
+
+	return ret;
+}
+
+unsigned long CLR_STACK_TRACE_get_records_dropped(CLR_STACK_TRACE* T){
+	return (atomic_load_explicit(&T->records_dropped, memory_order_relaxed));
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_TRACE_save(CLR_STACK_TRACE* T, FILE * file){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+	unsigned char version = CLR_STACK_TRACE_VERSION;
+	unsigned long long recorded = 0;
+	unsigned long long saved = 0;
+	int position = 0;
+	int block_size = 0;
+
+	if(file != 0){
+		ret = CLR_STACK_SUCCESS;
+
+		if(T->header_saved == false){
+			if((fwrite(CLR_STACK_TRACE_MAGIC, 1, 4, file) == 4) && (fwrite(&version, 1, 1, file) == 1))
+				T->header_saved = true;
+			else
+				ret = CLR_STACK_ERROR_UNKNOWN;
+		}
+
+		//Acquire, so the records are read after seeing the counter that published them
+		recorded = atomic_load_explicit(&T->bytes_recorded, memory_order_acquire);
+		saved = atomic_load_explicit(&T->bytes_saved, memory_order_relaxed);
+
+		//Records are written straight from the ring, in blocks that never cross its end
+		while((ret == CLR_STACK_SUCCESS) && (saved != recorded)){
+			position = (int)(saved % (unsigned long long)T->size_maximum);
+			block_size = T->size_maximum - position;
+			if((unsigned long long)block_size > (recorded - saved))
+				block_size = (int)(recorded - saved);
+			if(block_size > CLR_STACK_TRACE_SAVE_BLOCK)
+				block_size = CLR_STACK_TRACE_SAVE_BLOCK;
+
+			if(fwrite(&T->buffer[position], 1, block_size, file) == (size_t)block_size){
+				saved = saved + block_size;
+				//Release, so the record functions only reuse the space once it has been written
+				atomic_store_explicit(&T->bytes_saved, saved, memory_order_release);
+			}
+			else
+				ret = CLR_STACK_ERROR_UNKNOWN;
+		}
+	}
+	else
+		ret = CLR_STACK_ERROR_NULL_POINTER;
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_TRACE_load_header(FILE * file){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+	unsigned char header[5] = { 0 };
+
+	if(file != 0){
+		if((fread(header, 1, 5, file) == 5) && (memcmp(header, CLR_STACK_TRACE_MAGIC, 4) == 0) && (header[4] == CLR_STACK_TRACE_VERSION))
+			ret = CLR_STACK_SUCCESS;
+		else
+			ret = CLR_STACK_ERROR_WRONG_MODE;
+	}
+	else
+		ret = CLR_STACK_ERROR_NULL_POINTER;
+
+	return ret;
+}
+
+CLR_STACK_ERROR_CODES CLR_STACK_TRACE_load_record(FILE * file, CLR_STACK_TRACE_RECORD * record){
+	CLR_STACK_ERROR_CODES ret = CLR_STACK_ERROR_UNKNOWN;
+	int c = 0;
+	unsigned long long thread = 0;
+	unsigned long long size = 0;
+
+	if((file != 0) && (record != 0)){
+		c = fgetc(file);
+		if(c != EOF){
+			record->operation = (CLR_STACK_TRACE_OPERATIONS)(c & 0x0F);
+			record->failed = ((c & CLR_STACK_TRACE_FAILED_FLAG) != 0);
+
+			if((record->operation >= CLR_STACK_TRACE_PUSH) && (record->operation <= CLR_STACK_TRACE_PEEK)
+					&& CLR_STACK_TRACE_decode_varint(file, &thread)
+					&& CLR_STACK_TRACE_decode_varint(file, &size)
+					&& CLR_STACK_TRACE_decode_varint(file, &record->time_delta)){
+				record->thread = (unsigned int)thread;
+				record->size = (unsigned int)size;
+				ret = CLR_STACK_SUCCESS;
+			}
+			else
+				ret = CLR_STACK_ERROR_WRONG_MODE;
+		}
+		else
+			ret = CLR_STACK_ERROR_POP_NOT_ENOUGH_BYTES;
+	}
+	else
+		ret = CLR_STACK_ERROR_NULL_POINTER;
+
+	return ret;
+}
@@ -0,0 +1,173 @@
+/////////////////////////////////////////////////
+//
+//	This file is part of CLR_Stack.
+//
+//	CLR_Stack is free software: you can redistribute it and/or modify
+//	it under the terms of the GNU Lesser General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or
+//	(at your option) any later version.
+//
+//	CLR_Stack is distributed in the hope that it will be useful,
+//	but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//	GNU Lesser General Public License for more details.
+//
+//	You should have received a copy of the GNU Lesser General Public License
+//	along with CLR_Stack.  If not, see <https://www.gnu.org/licenses/>.
+//
+/////////////////////////////////////////////////
+
+#ifndef __CLR_STACK_TRACE_H_
+#define __CLR_STACK_TRACE_H_
+
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <stdio.h>
+
+#include "CLR_Stack.h"
+
+#define CLR_STACK_TRACE_MAGIC "CLRT"		///< First bytes of a trace file
+#define CLR_STACK_TRACE_VERSION 1			///< Version of the trace file format, written after the magic
+#define CLR_STACK_TRACE_RECORD_SIZE_MAXIMUM 21	///< Maximum size in bytes of an encoded record
+
+/**
+ * Operations recorded in a trace
+ * */
+typedef enum{
+	CLR_STACK_TRACE_PUSH = 1,	///< CLR_STACK_push
+	CLR_STACK_TRACE_POP = 2,	///< CLR_STACK_pop
+	CLR_STACK_TRACE_PEEK = 3,	///< CLR_STACK_peek
+}CLR_STACK_TRACE_OPERATIONS;
+
+/**
+ * Function giving the current time in nanoseconds (or any other unit, as long as the whole trace uses the same one).
+ * */
+typedef unsigned long long (*CLR_STACK_TRACE_CLOCK)(void);
+
+/**
+ * A single decoded trace record.
+ * In the file every record is encoded as one byte with the operation (low 4 bits) and a failure flag (bit 4),
+ * followed by the thread, the size and the time since the previous record as little endian base 128 varints.
+ * */
+typedef struct st_CLR_STACK_TRACE_RECORD{
+	CLR_STACK_TRACE_OPERATIONS operation;	///< Operation done on the stack
+	bool failed;							///< true if the operation did not return CLR_STACK_SUCCESS
+	unsigned int thread;					///< Thread that did the operation, as given by the caller
+	unsigned int size;						///< Size in bytes passed to the operation
+	unsigned long long time_delta;			///< Time since the previous record, in CLR_STACK_TRACE_CLOCK units
+}CLR_STACK_TRACE_RECORD;
+
+/**
+ * CLR_STACK_TRACE Structure, records the operations done on CLR_STACK structures in a compact binary trace.
+ * Encoded records are kept in a ring buffer over the memory block passed with init, and written to a file with
+ * CLR_STACK_TRACE_save. Records that do not fit in the memory block are dropped and counted, the stack is never slowed down
+ * waiting for the file.
+ * The ring buffer has a single producer and a single consumer: the record functions (CLR_STACK_TRACE_push/pop/peek) of a T
+ * MUST NOT run at the same time, so if the traced stack is shared by several threads they MUST be called while holding the
+ * lock that already protects it. CLR_STACK_TRACE_save takes no lock and can run at the same time from one other thread.
+ * The structure MUST be aligned to CLR_STACK_CACHE_LINE_SIZE: declare it statically (or on the stack), or allocate it
+ * with aligned_alloc. malloc only guarantees the alignment of max_align_t, which is usually smaller.
+ * Needs a C11 compiler with <stdatomic.h>.
+ * YOU SHALL NOT interact with its elements, the functions given below will manage it safely.
+ * */
+typedef struct st_CLR_STACK_TRACE{
+	unsigned char * buffer;				///< Memory block holding the encoded records not saved yet
+	int size_maximum;					///< Size of the memory block in bytes
+	CLR_STACK_TRACE_CLOCK clock;		///< Function giving the time of every record, can be NULL
+	unsigned long long time_last;		///< Time of the last record kept, only used by the record functions
+	atomic_ulong records_dropped;		///< Number of records dropped because the buffer was full
+	bool header_saved;					///< true once the file header was written by CLR_STACK_TRACE_save
+	_Alignas(CLR_STACK_CACHE_LINE_SIZE) atomic_ullong bytes_recorded;	///< Total bytes recorded since init, only written by the record functions
+	_Alignas(CLR_STACK_CACHE_LINE_SIZE) atomic_ullong bytes_saved;	///< Total bytes saved since init, only written by CLR_STACK_TRACE_save
+}CLR_STACK_TRACE;
+
+/**
+ * Function for set-up a CLR_STACK_TRACE structure, keeping its records in the memory passed in mem_chunk (of size size).
+ * This function MUST be called before any other for succesfull operation, and before any other thread uses T.
+ *
+ * \param T Pointer to the CLR_STACK_TRACE structure to set-up
+ * \param mem_chunk pointer to the memory block that will hold the records until they are saved
+ * \param size the size in BYTES of the memory block
+ * \param clock function giving the time of every record, NULL to record all of them with time 0
+ *
+ * \returns A CLR_STACK_ERROR_CODES value.
+ * \li CLR_STACK_SUCCESS if init succesful.
+ * \li CLR_STACK_ERROR_WRONG_SIZE if size < 1.
+ * \li CLR_STACK_ERROR_WRONG_ALIGNMENT if T is not aligned to CLR_STACK_CACHE_LINE_SIZE.
+ * \li CLR_STACK_ERROR_NULL_POINTER if T or mem_chunk is a NULL pointer.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_TRACE_init(CLR_STACK_TRACE* T, unsigned char * mem_chunk, int size, CLR_STACK_TRACE_CLOCK clock);
+
+/**
+ * Same as CLR_STACK_push, recording the operation in T.
+ * Calls on the same T MUST be serialized, see CLR_STACK_TRACE.
+ * \param thread number identifying the calling thread in the trace.
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_TRACE_push(CLR_STACK_TRACE* T, CLR_STACK* S, unsigned int thread, unsigned char * bytes, int size);
+
+/**
+ * Same as CLR_STACK_pop, recording the operation in T.
+ * Calls on the same T MUST be serialized, see CLR_STACK_TRACE.
+ * \param thread number identifying the calling thread in the trace.
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_TRACE_pop(CLR_STACK_TRACE* T, CLR_STACK* S, unsigned int thread, unsigned char * bytes, int size);
+
+/**
+ * Same as CLR_STACK_peek, recording the operation in T.
+ * Calls on the same T MUST be serialized, see CLR_STACK_TRACE.
+ * \param thread number identifying the calling thread in the trace.
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_TRACE_peek(CLR_STACK_TRACE* T, CLR_STACK* S, unsigned int thread, unsigned char * bytes, int size);
+
+/**
+ * Returns the number of records dropped because the memory block of T was full.
+ * Save more often or use a bigger memory block if it is not 0.
+ * */
+unsigned long CLR_STACK_TRACE_get_records_dropped(CLR_STACK_TRACE* T);
+
+/**
+ * Function for writing all the records kept in T at the end of file, taking them out of T.
+ * The first call also writes the file header, so all the calls for a trace MUST use the same file.
+ * It can run while other threads record into T, but only one thread at a time may save T.
+ *
+ * \param T Pointer to the CLR_STACK_TRACE structure to save.
+ * \param file file opened for writing in binary mode.
+ *
+ * \returns A CLR_STACK_ERROR_CODES value:
+ * \li CLR_STACK_SUCCESS if all the records were written.
+ * \li CLR_STACK_ERROR_UNKNOWN if the file could not be written.
+ * \li CLR_STACK_ERROR_NULL_POINTER if file is a NULL pointer.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_TRACE_save(CLR_STACK_TRACE* T, FILE * file);
+
+/**
+ * Function for checking the header of a trace file, it MUST be called before reading its records.
+ *
+ * \param file trace file opened for reading in binary mode, at its beginning.
+ *
+ * \returns A CLR_STACK_ERROR_CODES value:
+ * \li CLR_STACK_SUCCESS if the file is a trace of a known version.
+ * \li CLR_STACK_ERROR_WRONG_MODE if the file is not a trace or its version is not known.
+ * \li CLR_STACK_ERROR_NULL_POINTER if file is a NULL pointer.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_TRACE_load_header(FILE * file);
+
+/**
+ * Function for reading the next record of a trace file.
+ *
+ * \param file trace file opened for reading in binary mode, after CLR_STACK_TRACE_load_header.
+ * \param record pointer to the structure in which the record will be written.
+ *
+ * \returns A CLR_STACK_ERROR_CODES value:
+ * \li CLR_STACK_SUCCESS if a record was read.
+ * \li CLR_STACK_ERROR_POP_NOT_ENOUGH_BYTES if the end of the file was reached.
+ * \li CLR_STACK_ERROR_WRONG_MODE if the record is not valid.
+ * \li CLR_STACK_ERROR_NULL_POINTER if file or record is a NULL pointer.
+ *
+ * */
+CLR_STACK_ERROR_CODES CLR_STACK_TRACE_load_record(FILE * file, CLR_STACK_TRACE_RECORD * record);
+
+#endif //__CLR_STACK_TRACE_H_